@@ -11,6 +11,13 @@
 
 #pragma once
 
+#include "bit_matrix.hpp"
+#include "external_sort.hpp"
+#include "graph.hpp"
+#include "graph_io.hpp"
+#include "primes.hpp"
+#include "sort.hpp"
+
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -42,20 +49,21 @@ namespace algo {
 
 	void reverseMatrixColumn(std::vector<std::vector<int>>& mat, int col);
 
-	//int kruskalMst(const std::vector<std::vector<int>>& adj, int n);
+	int kruskalMst(const std::vector<std::vector<int>>& adj, int n);
 
 	std::vector<int> dfs(const std::vector<std::vector<int>>& adj, int root);
 
 	std::vector<int> bfs(const std::vector<std::vector<int>>& adj, int root);
 
-	//int shortestPath(const std::vector<std::vector<int>>& adj, int root);
+	ShortestPaths shortestPath(const std::vector<std::vector<int>>& adj,
+							   int root);
 
 	std::vector<int> rdfs(const std::vector<std::vector<int>>& adj, int root);
 
 	void rdfsHelper(const std::vector<std::vector<int>>& adj, int root,
 				 std::vector<bool>& visited, std::vector<int>& path);
 
-	void rdfsTimed(const std::vector<std::vector<int>>& adj, int root);
+	DfsResult rdfsTimed(const std::vector<std::vector<int>>& adj, int root);
 
 	void rdfsTimedHelper(const std::vector<std::vector<int>>& adj, int root, 
 					  std::vector<int>& color, int& timer, 
@@ -0,0 +1,65 @@
+/**
+ * @file aligned_allocator.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Allocator for over-aligned buffers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace algo {
+	/**
+	 * Standard allocator whose blocks start on an Align-byte boundary, e.g.
+	 * std::vector<uint64_t, AlignedAllocator<uint64_t, 64>> for buffers that
+	 * start on a cache line and can be read with aligned SIMD loads.
+	 */
+	template <typename T, std::size_t Align>
+	struct AlignedAllocator {
+		static_assert(Align >= alignof(void*) && (Align & (Align - 1)) == 0,
+					  "Align must be a power of two of at least pointer size");
+
+		using value_type = T;
+
+		template <typename U>
+		struct rebind {
+			using other = AlignedAllocator<U, Align>;
+		};
+
+		AlignedAllocator() = default;
+
+		template <typename U>
+		AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+				throw std::bad_array_new_length();
+			}
+			const std::size_t bytes = n * sizeof(T);
+			void* p = nullptr;
+			if (posix_memalign(&p, Align, bytes != 0 ? bytes : Align)) {
+				throw std::bad_alloc();
+			}
+			return static_cast<T*>(p);
+		}
+
+		void deallocate(T* p, std::size_t) { std::free(p); }
+
+		template <typename U>
+		bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+
+		template <typename U>
+		bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+	};
+} // namespace algo
+
+// ALIGNED_ALLOCATOR_HPP
@@ -0,0 +1,82 @@
+/**
+ * @file bit_matrix.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Bit-packed adjacency matrix for dense graphs.
+ */
+
+#pragma once
+
+#include "aligned_allocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algo {
+	/**
+	 * Adjacency matrix with one bit per cell, 32 times smaller than a
+	 * std::vector<std::vector<int>> and in a single allocation.
+	 *
+	 * Every row starts on a 64-byte boundary and is padded to a whole number
+	 * of cache lines, so a row can be combined with a bitmap of the same
+	 * layout (such as a visited set) one SIMD register at a time. Padding
+	 * bits are always zero.
+	 */
+	class BitMatrix {
+	public:
+		/** Words per cache line, the unit rows are padded to. */
+		static constexpr std::size_t LINE_WORDS = 8;
+
+		using Words = std::vector<std::uint64_t, AlignedAllocator<std::uint64_t, 64>>;
+
+		BitMatrix() = default;
+
+		/** An n x n matrix with no edges. */
+		explicit BitMatrix(int n);
+
+		/** Any non-zero cell of adj becomes an edge. */
+		static BitMatrix fromMatrix(const std::vector<std::vector<int>>& adj);
+
+		int size() const { return n_; }
+
+		/** Words per row, padding included; also the size of a row bitmap. */
+		std::size_t rowWords() const { return stride_; }
+
+		bool test(int r, int c) const
+		{
+			return (row(r)[c >> 6] >> (c & 63)) & 1;
+		}
+
+		void set(int r, int c) { row(r)[c >> 6] |= std::uint64_t(1) << (c & 63); }
+
+		void reset(int r, int c)
+		{
+			row(r)[c >> 6] &= ~(std::uint64_t(1) << (c & 63));
+		}
+
+		const std::uint64_t* row(int r) const { return words_.data() + r * stride_; }
+
+		std::uint64_t* row(int r) { return words_.data() + r * stride_; }
+
+		/** Number of set cells. */
+		std::uint64_t numEdges() const;
+
+	private:
+		int n_ = 0;
+		std::size_t stride_ = 0;
+		Words words_;
+	};
+
+	std::vector<int> bfs(const BitMatrix& adj, int root);
+
+	std::vector<int> dfs(const BitMatrix& adj, int root);
+
+	std::vector<int> rdfs(const BitMatrix& adj, int root);
+} // namespace algo
+
+// BIT_MATRIX_HPP
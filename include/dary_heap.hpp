@@ -0,0 +1,137 @@
+/**
+ * @file dary_heap.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Indexed d-ary min-heap with decrease-key.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace algo {
+	/**
+	 * Min-heap over the ids [0, n), each with a key, that can lower the key of
+	 * an id already in the heap.
+	 *
+	 * A position table maps every id to its slot, so decreaseKey() is a
+	 * sift-up from a known slot instead of a search. With D children per
+	 * node the tree is log_D(n) deep: sift-up (push, decreaseKey) gets
+	 * cheaper as D grows and sift-down (pop) gets more comparisons per level
+	 * but fewer levels, and all children of a node share a cache line for
+	 * small keys. D = 4 is a good default for graph algorithms, which do many
+	 * more decrease-keys than pops.
+	 *
+	 * @tparam Key Totally ordered key type.
+	 * @tparam D Number of children per node, at least 2.
+	 */
+	template <typename Key, int D = 4>
+	class IndexedDaryHeap {
+		static_assert(D >= 2, "IndexedDaryHeap needs at least two children");
+
+	public:
+		explicit IndexedDaryHeap(int n) : pos_(n, -1), key_(n) {}
+
+		bool empty() const { return heap_.empty(); }
+
+		std::size_t size() const { return heap_.size(); }
+
+		bool contains(int id) const { return pos_[id] != -1; }
+
+		const Key& key(int id) const { return key_[id]; }
+
+		/** Id with the smallest key. @pre !empty() */
+		int top() const { return heap_.front(); }
+
+		/** @pre !contains(id) */
+		void push(int id, const Key& key)
+		{
+			key_[id] = key;
+			pos_[id] = static_cast<int>(heap_.size());
+			heap_.push_back(id);
+			siftUp(pos_[id]);
+		}
+
+		/** @pre contains(id) and key is not greater than key(id). */
+		void decreaseKey(int id, const Key& key)
+		{
+			key_[id] = key;
+			siftUp(pos_[id]);
+		}
+
+		/** Removes and returns the id with the smallest key. @pre !empty() */
+		int pop()
+		{
+			int id = heap_.front();
+			pos_[id] = -1;
+			int last = heap_.back();
+			heap_.pop_back();
+			if (!heap_.empty()) {
+				heap_[0] = last;
+				pos_[last] = 0;
+				siftDown(0);
+			}
+			return id;
+		}
+
+	private:
+		// The element moving through the tree is held aside and written
+		// once at its final slot, instead of swapped at every level.
+		void siftUp(int i)
+		{
+			int id = heap_[i];
+			while (i > 0) {
+				int parent = (i - 1) / D;
+				if (!(key_[id] < key_[heap_[parent]])) {
+					break;
+				}
+				place(i, heap_[parent]);
+				i = parent;
+			}
+			place(i, id);
+		}
+
+		void siftDown(int i)
+		{
+			const int n = static_cast<int>(heap_.size());
+			int id = heap_[i];
+			for (;;) {
+				int first = i * D + 1;
+				if (first >= n) {
+					break;
+				}
+				int last = first + D < n ? first + D : n;
+				int best = first;
+				for (int c = first + 1; c < last; ++c) {
+					if (key_[heap_[c]] < key_[heap_[best]]) {
+						best = c;
+					}
+				}
+				if (!(key_[heap_[best]] < key_[id])) {
+					break;
+				}
+				place(i, heap_[best]);
+				i = best;
+			}
+			place(i, id);
+		}
+
+		void place(int i, int id)
+		{
+			heap_[i] = id;
+			pos_[id] = i;
+		}
+
+		std::vector<int> heap_;	// ids in heap order
+		std::vector<int> pos_;	// slot of each id, -1 if not in the heap
+		std::vector<Key> key_;
+	};
+} // namespace algo
+
+// DARY_HEAP_HPP
@@ -0,0 +1,81 @@
+/**
+ * @file external_sort.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * External merge sort of binary files larger than memory.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace algo {
+	struct ExternalSortOptions {
+		/**
+		 * Bytes of element buffers the sort may hold at once. At least
+		 * EXTERNAL_SORT_MIN_MEMORY; bigger means longer runs and fewer merge
+		 * passes.
+		 */
+		std::size_t memoryBytes = std::size_t(256) << 20;
+
+		/**
+		 * Directory for the temporary run files. Empty means the directory
+		 * of the output file.
+		 */
+		std::string tempDir;
+
+		/**
+		 * Read the next chunk of input while sorting the current one, and
+		 * write merged output while merging the next block, each on a
+		 * background thread. Halves the chunk size, since two chunks are
+		 * in memory at once.
+		 */
+		bool overlapIo = true;
+	};
+
+	/** Smallest ExternalSortOptions::memoryBytes accepted. */
+	constexpr std::size_t EXTERNAL_SORT_MIN_MEMORY = std::size_t(16) << 10;
+
+	/** What an external sort did. */
+	struct ExternalSortStats {
+		std::uint64_t elements = 0;
+		std::uint64_t runs = 0;			///< Sorted runs the input was cut into.
+		int mergePasses = 0;			///< Passes over the data after the runs.
+	};
+
+	/**
+	 * Sorts a file holding an array of T in host byte order into another,
+	 * ascending, in bounded memory.
+	 *
+	 * The input is read in chunks as large as the memory budget allows.
+	 * Each chunk is sorted in place with pdqSort() and written as a run to
+	 * an unlinked temporary file, so nothing is left behind if the process
+	 * dies. The runs are then merged, as many at a time as the budget
+	 * allows one read buffer each for, through a heap of their heads; if
+	 * there are more runs than that, intermediate passes merge groups of
+	 * them into longer runs first. I/O is buffered reads and writes of
+	 * whole blocks. Input that fits one chunk skips the temporary files.
+	 *
+	 * The output is only opened once the input has been read in full, so
+	 * it may be the input file.
+	 *
+	 * @tparam T std::int32_t, std::uint32_t, std::int64_t or std::uint64_t.
+	 *
+	 * @throw std::invalid_argument If options.memoryBytes is below
+	 * EXTERNAL_SORT_MIN_MEMORY.
+	 * @throw std::runtime_error If a file cannot be read or written, or the
+	 * input size is not a multiple of sizeof(T).
+	 */
+	template <typename T>
+	ExternalSortStats externalSort(const std::string& input,
+								   const std::string& output,
+								   const ExternalSortOptions& options = {});
+} // namespace algo
+
+// EXTERNAL_SORT_HPP
@@ -0,0 +1,426 @@
+/**
+ * @file graph.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Sparse graph representation and the graph algorithms that run on it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace algo {
+	class ThreadPool;
+
+	/**
+	 * A directed, optionally weighted edge. Unweighted edges have a weight of
+	 * one.
+	 */
+	struct Edge {
+		int from;
+		int to;
+		int weight;
+	};
+
+	/**
+	 * Read-only view of a contiguous run of elements, so rows of a graph can
+	 * be iterated with range-for without copying.
+	 */
+	template <typename T>
+	struct Range {
+		const T* first;
+		const T* last;
+
+		const T* begin() const { return first; }
+		const T* end() const { return last; }
+		std::size_t size() const { return last - first; }
+		bool empty() const { return first == last; }
+		const T& operator[](std::size_t i) const { return first[i]; }
+	};
+
+	/**
+	 * Compressed sparse row (CSR) graph.
+	 *
+	 * The neighbors of vertex v are stored contiguously in
+	 * neighbors[offsets[v], offsets[v + 1]), so a graph takes V + 1 offsets and
+	 * E neighbors (plus E weights, if weighted) instead of V^2 matrix cells,
+	 * and visiting every row is O(V + E).
+	 *
+	 * A graph is an immutable view over its three arrays plus a shared handle
+	 * on whatever owns them: vectors moved in by the builders, or a read-only
+	 * file mapping (see graph_io.hpp). Copies share the arrays.
+	 */
+	class CsrGraph {
+	public:
+		CsrGraph() = default;
+
+		/**
+		 * @param offsets Row offsets, size V + 1, non-decreasing, starting at
+		 * zero.
+		 * @param neighbors Column indices, size offsets.back().
+		 * @param weights Edge weights parallel to neighbors, or empty for an
+		 * unweighted graph.
+		 *
+		 * @throw std::invalid_argument If the arrays are inconsistent.
+		 */
+		CsrGraph(std::vector<std::uint64_t> offsets, std::vector<int> neighbors,
+				 std::vector<int> weights = {});
+
+		/**
+		 * Wraps arrays owned elsewhere without copying or checking them.
+		 *
+		 * @param n The number of vertices.
+		 * @param offsets n + 1 row offsets.
+		 * @param neighbors offsets[n] column indices.
+		 * @param weights offsets[n] weights, or null for an unweighted graph.
+		 * @param owner Keeps the arrays alive for as long as any copy of the
+		 * graph exists.
+		 */
+		static CsrGraph view(int n, const std::uint64_t* offsets,
+							 const int* neighbors, const int* weights,
+							 std::shared_ptr<const void> owner);
+
+		/**
+		 * Builds an unweighted graph from an edge list.
+		 *
+		 * @param n The number of vertices.
+		 * @param edges The edges as { from, to } pairs.
+		 * @param directed If false, each edge is stored in both directions.
+		 *
+		 * @note Rows keep the relative order the edges were given in.
+		 */
+		static CsrGraph fromEdges(int n,
+								  const std::vector<std::pair<int, int>>& edges,
+								  bool directed = true);
+
+		/**
+		 * Builds a weighted graph from an edge list.
+		 *
+		 * @param n The number of vertices.
+		 * @param edges The weighted edges.
+		 * @param directed If false, each edge is stored in both directions.
+		 *
+		 * @note Rows keep the relative order the edges were given in.
+		 */
+		static CsrGraph fromEdges(int n, const std::vector<Edge>& edges,
+								  bool directed = true);
+
+		/**
+		 * Builds a graph from an adjacency matrix, where any non-zero cell is
+		 * an edge.
+		 *
+		 * @param adj The adjacency matrix.
+		 * @param weighted If true, the cell values are kept as edge weights.
+		 */
+		static CsrGraph fromMatrix(const std::vector<std::vector<int>>& adj,
+								   bool weighted = false);
+
+		/**
+		 * Builds the reverse graph, where every edge u -> v becomes v -> u.
+		 * Row v of the transpose lists the in-neighbors of v.
+		 */
+		CsrGraph transpose() const;
+
+		/**
+		 * Checks that the offsets are non-decreasing from zero to E and that
+		 * every neighbor is a vertex, in O(V + E).
+		 *
+		 * @throw std::invalid_argument If not.
+		 */
+		void validate() const;
+
+		int numVertices() const { return n_; }
+
+		std::uint64_t numEdges() const { return n_ ? offsets_[n_] : 0; }
+
+		bool weighted() const { return weights_ != nullptr; }
+
+		std::uint64_t degree(int v) const
+		{
+			return offsets_[v + 1] - offsets_[v];
+		}
+
+		/** Index of the first edge of vertex v; edges of v end at offset(v + 1). */
+		std::uint64_t offset(int v) const { return offsets_[v]; }
+
+		/** Target of edge e. */
+		int target(std::uint64_t e) const { return neighbors_[e]; }
+
+		/** Weight of edge e, or one if the graph is unweighted. */
+		int weight(std::uint64_t e) const
+		{
+			return weights_ ? weights_[e] : 1;
+		}
+
+		Range<int> neighbors(int v) const
+		{
+			return { neighbors_ + offsets_[v], neighbors_ + offsets_[v + 1] };
+		}
+
+		/** @pre The graph is weighted. */
+		Range<int> weights(int v) const
+		{
+			return { weights_ + offsets_[v], weights_ + offsets_[v + 1] };
+		}
+
+		Range<std::uint64_t> offsets() const
+		{
+			return { offsets_, offsets_ + (n_ ? n_ + 1 : 0) };
+		}
+
+		Range<int> neighborArray() const
+		{
+			return { neighbors_, neighbors_ + numEdges() };
+		}
+
+		/** Empty if the graph is unweighted. */
+		Range<int> weightArray() const
+		{
+			return { weights_, weights_ ? weights_ + numEdges() : weights_ };
+		}
+
+	private:
+		int n_ = 0;
+		const std::uint64_t* offsets_ = nullptr;
+		const int* neighbors_ = nullptr;
+		const int* weights_ = nullptr;
+		std::shared_ptr<const void> owner_;
+	};
+
+	/**
+	 * Result of a breadth-first search. Unreached vertices have a distance and
+	 * parent of -1; the root is its own parent.
+	 */
+	struct BfsResult {
+		std::vector<int> path;	// visit order, same as bfs()
+		std::vector<int> dist;	// hops from the root
+		std::vector<int> parent;	// BFS tree
+	};
+
+	std::vector<int> bfs(const CsrGraph& g, int root);
+
+	/**
+	 * Direction-optimizing breadth-first search (Beamer et al.).
+	 *
+	 * Each level is expanded either top-down (frontier vertices scan their
+	 * out-edges) or bottom-up (unvisited vertices scan their in-edges for a
+	 * parent in the frontier, stopping at the first hit). Bottom-up wins once
+	 * the frontier holds a large share of the remaining edges, which happens
+	 * in the middle levels of low-diameter graphs. The frontier and the
+	 * visited set are bitmaps.
+	 *
+	 * @param g The graph.
+	 * @param reverse The transpose of g, used for the bottom-up steps.
+	 * @param root The source vertex.
+	 * @param alpha Switch to bottom-up when the frontier's out-edges exceed
+	 * 1/alpha of the unexplored edges.
+	 * @param beta Switch back to top-down when the frontier shrinks below
+	 * 1/beta of the vertices.
+	 *
+	 * @return Distances, parents and the visit order. The order is level by
+	 * level like bfs(), but within a bottom-up level vertices appear in id
+	 * order.
+	 */
+	BfsResult directionOptimizingBfs(const CsrGraph& g, const CsrGraph& reverse,
+									 int root, int alpha = 14, int beta = 24);
+
+	/**
+	 * @pre g is undirected (symmetric), so it is its own transpose.
+	 */
+	BfsResult directionOptimizingBfs(const CsrGraph& g, int root,
+									 int alpha = 14, int beta = 24);
+
+	/**
+	 * Level-synchronous parallel breadth-first search.
+	 *
+	 * Each level's frontier is split into chunks that the pool's threads
+	 * claim dynamically. A thread claims a vertex by compare-and-swapping its
+	 * parent from -1, so every vertex is discovered exactly once, and appends
+	 * it to a thread-local buffer. At the end of the level the buffers are
+	 * concatenated into the next frontier.
+	 *
+	 * @return Distances, parents and the visit order. The order is level by
+	 * level like bfs(), but the order within a level depends on scheduling.
+	 */
+	BfsResult parallelBfs(const CsrGraph& g, int root, ThreadPool& pool);
+
+	std::vector<int> dfs(const CsrGraph& g, int root);
+
+	/**
+	 * Result of a depth-first search. Discovery and finish times come from
+	 * one clock that ticks on both events, so they lie in [0, 2V) and the
+	 * interval of a descendant nests inside the interval of its ancestor.
+	 * Unreached vertices have times and parent of -1; a root is its own
+	 * parent.
+	 */
+	struct DfsResult {
+		std::vector<int> preorder;
+		std::vector<int> postorder;
+		std::vector<int> discovery;
+		std::vector<int> finish;
+		std::vector<int> parent;
+	};
+
+	/**
+	 * Depth-first search from root on an explicit stack, so the depth of the
+	 * graph is limited by memory rather than by the call stack. Neighbors are
+	 * explored in row order, like the recursive rdfs().
+	 */
+	DfsResult depthFirstSearch(const CsrGraph& g, int root);
+
+	/**
+	 * Depth-first search of the whole graph: every vertex not reached yet
+	 * starts a new tree, in increasing vertex order.
+	 */
+	DfsResult depthFirstSearch(const CsrGraph& g);
+
+	std::vector<int> rdfs(const CsrGraph& g, int root);
+
+	std::vector<int> topologicalSort(const CsrGraph& g);
+
+	/**
+	 * Result of Kahn's topological sort.
+	 *
+	 * The order is grouped into levels: level 0 holds the vertices with no
+	 * incoming edges, and level i the vertices whose predecessors all lie in
+	 * levels below i, so the vertices of one level never depend on each other
+	 * and can run concurrently once the previous levels are done. Level i is
+	 * order[levelOffsets[i], levelOffsets[i + 1]).
+	 *
+	 * If the graph has a cycle, order and the levels only cover the vertices
+	 * that do not depend on it, and cycle holds one directed cycle
+	 * v0 -> v1 -> ... -> vk -> v0 as { v0, ..., vk }.
+	 */
+	struct TopologicalOrder {
+		std::vector<int> order;
+		std::vector<int> levelOffsets;
+		std::vector<int> cycle;
+
+		bool acyclic() const { return cycle.empty(); }
+
+		int numLevels() const
+		{
+			return static_cast<int>(levelOffsets.size()) - 1;
+		}
+
+		Range<int> level(int i) const
+		{
+			return { order.data() + levelOffsets[i],
+					 order.data() + levelOffsets[i + 1] };
+		}
+	};
+
+	/**
+	 * Kahn's algorithm: repeatedly emit the vertices whose remaining
+	 * in-degree is zero, one level at a time, in O(V + E). Vertices within a
+	 * level are in increasing id order. Unlike topologicalSort(), a cycle is
+	 * detected and reported rather than producing an invalid order.
+	 */
+	TopologicalOrder kahnTopologicalSort(const CsrGraph& g);
+
+	int primMst(const CsrGraph& g);
+
+	/**
+	 * A minimum spanning tree or forest: its edges and their total weight.
+	 */
+	struct MstResult {
+		std::vector<Edge> edges;
+		std::int64_t cost;
+	};
+
+	/**
+	 * Prim's algorithm with an indexed 4-ary heap and decrease-key, in
+	 * O(E log V) time and O(V) heap space. Every vertex not yet spanned
+	 * starts a new tree, so a disconnected graph yields a minimum spanning
+	 * forest with one tree per component.
+	 *
+	 * @pre g is undirected (each edge is stored in both directions).
+	 *
+	 * @return The forest edges as { parent, child, weight }, in the order
+	 * they were added, and the total weight as a 64-bit sum.
+	 */
+	MstResult primMsf(const CsrGraph& g);
+
+	/**
+	 * Single-source shortest paths: the distance of every vertex from the
+	 * root, -1 if unreachable, and its predecessor on a shortest path, -1 if
+	 * unreachable. The root is its own predecessor.
+	 */
+	struct ShortestPaths {
+		std::vector<std::int64_t> dist;
+		std::vector<int> parent;
+	};
+
+	/**
+	 * Dijkstra's algorithm with a radix heap. Distances only grow as they are
+	 * settled, which is all a radix heap needs, and it pushes in O(1) and pops
+	 * in amortized O(log C) for path lengths up to C, without decrease-key:
+	 * an improved vertex is pushed again and the stale entry skipped.
+	 *
+	 * @throw std::invalid_argument If a reachable edge has a negative weight.
+	 */
+	ShortestPaths dijkstra(const CsrGraph& g, int root);
+
+	/**
+	 * Parallel delta-stepping (Meyer and Sanders), bucket-synchronous like
+	 * the GAP benchmark suite's version.
+	 *
+	 * Tentative distances are grouped into buckets of width delta. All the
+	 * vertices of the lowest non-empty bucket are relaxed in parallel, with
+	 * an atomic minimum on the distance; improved vertices go to thread-local
+	 * buckets, and the bucket is repeated until it stops refilling. Small
+	 * delta approaches Dijkstra (little wasted work, little parallelism);
+	 * large delta approaches Bellman-Ford. Predecessors are recovered at the
+	 * end by a parallel traversal of the edges that are tight for the final
+	 * distances, so they always form a tree.
+	 *
+	 * @param delta Bucket width; distances up to D need D / delta buckets.
+	 * Zero picks the maximum weight over the average degree.
+	 *
+	 * @throw std::invalid_argument If any edge has a negative weight.
+	 */
+	ShortestPaths deltaStepping(const CsrGraph& g, int root, ThreadPool& pool,
+								std::int64_t delta = 0);
+
+	/**
+	 * Kruskal's algorithm on an edge list: sort the edges by weight and keep
+	 * each one that joins two different trees of a union-find, in
+	 * O(E log E) time.
+	 *
+	 * @param n The number of vertices.
+	 * @param edges The undirected edges, each listed once.
+	 *
+	 * @return The minimum spanning forest, edges in increasing weight.
+	 */
+	MstResult kruskalMst(int n, const std::vector<Edge>& edges);
+
+	/**
+	 * Parallel Boruvka's algorithm on an edge list.
+	 *
+	 * Each round, every edge offers itself to both of its components with an
+	 * atomic minimum, so each component finds its lightest outgoing edge in
+	 * parallel. Those edges join the forest, the components they connect are
+	 * merged, and edges that now fall inside one component are dropped. The
+	 * number of components at least halves each round, so there are at most
+	 * log2(V) rounds. Ties are broken by edge index, which keeps the chosen
+	 * edges acyclic.
+	 *
+	 * @param n The number of vertices.
+	 * @param edges The undirected edges, each listed once; at most 2^32.
+	 * @param pool Threads to run on.
+	 *
+	 * @return The minimum spanning forest, edges in no particular order.
+	 */
+	MstResult boruvkaMst(int n, const std::vector<Edge>& edges,
+						 ThreadPool& pool);
+} // namespace algo
+
+// GRAPH_HPP
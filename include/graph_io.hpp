@@ -0,0 +1,96 @@
+/**
+ * @file graph_io.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Binary on-disk CSR format, its memory-mapped loader and the text edge list
+ * converter.
+ */
+
+#pragma once
+
+#include "graph.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace algo {
+	/**
+	 * Header of a binary CSR file, followed by the offsets (numVertices + 1
+	 * uint64_t), the neighbors (numEdges int32_t) and, if the weighted flag is
+	 * set, the weights (numEdges int32_t). Each array starts on a 64-byte
+	 * boundary at the byte position given in the header, so a mapping of the
+	 * file can be used in place. All values are in host byte order;
+	 * byteOrder tells a file written on a machine of the other endianness
+	 * apart.
+	 */
+	struct CsrFileHeader {
+		static constexpr std::uint32_t VERSION = 1;
+		static constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+		static constexpr std::uint32_t WEIGHTED = 1;
+
+		char magic[8];				///< "ALGOCSR" and a NUL.
+		std::uint32_t version;
+		std::uint32_t flags;
+		std::uint64_t numVertices;
+		std::uint64_t numEdges;
+		std::uint64_t offsetsAt;
+		std::uint64_t neighborsAt;
+		std::uint64_t weightsAt;	///< Zero if unweighted.
+		std::uint32_t byteOrder;
+		std::uint32_t reserved;
+	};
+
+	static_assert(sizeof(CsrFileHeader) == 64, "CsrFileHeader must be 64 bytes");
+
+	/**
+	 * Writes a graph in the binary CSR format.
+	 *
+	 * @throw std::runtime_error If the file cannot be written.
+	 */
+	void saveCsr(const CsrGraph& g, const std::string& path);
+
+	/**
+	 * Maps a binary CSR file read-only and returns a graph that views the
+	 * mapping directly: nothing is read or copied until the pages are
+	 * touched, and the mapping lives as long as any copy of the graph.
+	 *
+	 * The header and the array bounds are always checked against the file
+	 * size, which is O(1).
+	 *
+	 * @param verify If true, also run CsrGraph::validate(), which reads the
+	 * whole file.
+	 *
+	 * @throw std::runtime_error If the file cannot be mapped or is not a
+	 * valid CSR file.
+	 * @throw std::invalid_argument If verify is set and the arrays are
+	 * inconsistent.
+	 */
+	CsrGraph loadCsr(const std::string& path, bool verify = false);
+
+	/**
+	 * Converts a text edge list to the binary CSR format.
+	 *
+	 * Each line holds "from to" or "from to weight" separated by blanks,
+	 * with zero-based vertex ids; blank lines and lines starting with '#' or
+	 * '%' are skipped. The graph has max id + 1 vertices and is weighted if
+	 * the edges have weights, which they must either all or none have.
+	 *
+	 * The input is read twice, once to count the degrees and once to
+	 * scatter the edges straight into a mapping of the output file, so only
+	 * O(V) memory is used however many edges there are. Rows keep the order
+	 * of the input, as with CsrGraph::fromEdges().
+	 *
+	 * @param directed If false, each edge is stored in both directions.
+	 *
+	 * @throw std::runtime_error If a file cannot be read or written, or the
+	 * input is malformed.
+	 */
+	void convertEdgeList(const std::string& textPath, const std::string& csrPath,
+						 bool directed = true);
+} // namespace algo
+
+// GRAPH_IO_HPP
@@ -0,0 +1,388 @@
+/**
+ * @file primes.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Prime sieves and prime counting for 64-bit bounds.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * isPrime() and countPrimes() answer from compile-time tables below this
+ * bound. Set through the ALGO_PRIME_TABLE_LIMIT cache variable in CMake;
+ * the tables take limit / 16 bytes of bitmap plus half that in counts.
+ */
+#ifndef ALGO_PRIME_TABLE_LIMIT
+#define ALGO_PRIME_TABLE_LIMIT (1 << 16)
+#endif
+
+namespace algo {
+	class ThreadPool;
+
+	/**
+	 * Bitmap of the odd primes below N, sieved at compile time: bit i % 64
+	 * of word i / 64 is set if 2i + 1 is a prime below N.
+	 */
+	template <std::uint32_t N>
+	constexpr std::array<std::uint64_t, (N + 127) / 128> oddPrimeBitmap()
+	{
+		static_assert(N >= 2, "oddPrimeBitmap needs N >= 2");
+		constexpr std::uint64_t size = (N + 127) / 128 * 64;
+		std::array<std::uint64_t, (N + 127) / 128> bits{};
+		for (auto& w : bits) {
+			w = ~std::uint64_t(0);
+		}
+		bits[0] &= ~std::uint64_t(1);	// 1 is not prime
+		for (std::uint64_t i = 1; (2 * i + 1) * (2 * i + 1) < N; ++i) {
+			if ((bits[i / 64] >> (i % 64)) & 1) {
+				const std::uint64_t p = 2 * i + 1;
+				for (std::uint64_t j = p * p / 2; j < size; j += p) {
+					bits[j / 64] &= ~(std::uint64_t(1) << (j % 64));
+				}
+			}
+		}
+		for (std::uint64_t i = N / 2; i < size; ++i) {	// 2i + 1 >= N
+			bits[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+		}
+		return bits;
+	}
+
+	/** Number of primes below N, at compile time. */
+	template <std::uint32_t N>
+	constexpr std::size_t primeCount()
+	{
+		std::size_t count = N > 2;
+		for (std::uint64_t w : oddPrimeBitmap<N>()) {
+			count += __builtin_popcountll(w);
+		}
+		return count;
+	}
+
+	/** The primes below N in increasing order, at compile time. */
+	template <std::uint32_t N>
+	constexpr std::array<std::uint32_t, primeCount<N>()> primeTable()
+	{
+		std::array<std::uint32_t, primeCount<N>()> primes{};
+		constexpr auto bits = oddPrimeBitmap<N>();
+		std::size_t k = 0;
+		if (N > 2) {
+			primes[k++] = 2;
+		}
+		for (std::size_t w = 0; w < bits.size(); ++w) {
+			for (std::uint64_t b = bits[w]; b; b &= b - 1) {
+				primes[k++] = static_cast<std::uint32_t>(
+					2 * (64 * w + __builtin_ctzll(b)) + 1);
+			}
+		}
+		return primes;
+	}
+
+	constexpr std::uint32_t PRIME_TABLE_LIMIT = ALGO_PRIME_TABLE_LIMIT;
+
+	/** oddPrimeBitmap() up to PRIME_TABLE_LIMIT. */
+	inline constexpr auto PRIME_BITMAP = oddPrimeBitmap<PRIME_TABLE_LIMIT>();
+
+	/** Number of odd primes in the words of PRIME_BITMAP before each word. */
+	inline constexpr auto PRIME_PREFIX = [] {
+		std::array<std::uint32_t, PRIME_BITMAP.size()> prefix{};
+		std::uint32_t count = 0;
+		for (std::size_t w = 0; w < PRIME_BITMAP.size(); ++w) {
+			prefix[w] = count;
+			count += __builtin_popcountll(PRIME_BITMAP[w]);
+		}
+		return prefix;
+	}();
+
+	/** Table lookup, usable in constant expressions. @pre n < PRIME_TABLE_LIMIT */
+	constexpr bool isSmallPrime(std::uint32_t n)
+	{
+		return n == 2
+			|| ((n & 1) && ((PRIME_BITMAP[n / 128] >> (n / 2 % 64)) & 1));
+	}
+
+	/**
+	 * Number of primes up to and including n, from PRIME_PREFIX and one
+	 * popcount. @pre n < PRIME_TABLE_LIMIT
+	 */
+	constexpr std::uint32_t smallPrimeCount(std::uint32_t n)
+	{
+		if (n < 2) {
+			return 0;
+		}
+		const std::uint32_t i = (n - 1) / 2;	// last odd number <= n
+		const std::uint64_t mask = ~std::uint64_t(0) >> (63 - i % 64);
+		return 1 + PRIME_PREFIX[i / 64]
+			+ __builtin_popcountll(PRIME_BITMAP[i / 64] & mask);
+	}
+
+	/**
+	 * All primes up to and including limit, with an odd-only sieve of
+	 * Eratosthenes in O(limit) bits. Meant for base-prime tables up to
+	 * sqrt(n) of the larger sieves.
+	 */
+	std::vector<std::uint32_t> primesUpTo(std::uint32_t limit);
+
+	/**
+	 * Number of primes up to and including n, with a segmented sieve of
+	 * Eratosthenes.
+	 *
+	 * Only odd numbers are stored, one bit each, and [0, n] is sieved one
+	 * segment at a time so the working set stays in cache; every segment is
+	 * then counted a word at a time with popcount. Memory is O(sqrt(n)) for
+	 * the base primes and their next multiples plus one segment, so bounds
+	 * far beyond RAM (10^12 and up) only cost time.
+	 *
+	 * @param segmentBytes Bytes per segment, rounded up to a whole number of
+	 * 64-bit words. Zero picks the size automatically: about sqrt(n) / 16, so
+	 * most base primes hit every segment, kept between the L1 and L2 sizes.
+	 */
+	std::uint64_t segmentedCountPrimes(std::uint64_t n,
+									   std::size_t segmentBytes = 0);
+
+	/**
+	 * Number of primes up to and including n, with the segmented sieve of
+	 * segmentedCountPrimes() run on every thread of pool.
+	 *
+	 * The segments are grouped into contiguous chunks that threads claim
+	 * dynamically; each thread keeps its own segment buffer and
+	 * next-multiple table, and all of them share one table of base primes.
+	 * Per-chunk counts are summed at the end, so there is no contention
+	 * while sieving.
+	 */
+	std::uint64_t parallelCountPrimes(std::uint64_t n, ThreadPool& pool,
+									  std::size_t segmentBytes = 0);
+
+	/**
+	 * The primes in [low, high], in increasing order, sieved in parallel as
+	 * in parallelCountPrimes(). Each chunk collects its own primes, which
+	 * are then concatenated in chunk order.
+	 */
+	std::vector<std::uint64_t> parallelPrimes(std::uint64_t low,
+											  std::uint64_t high,
+											  ThreadPool& pool,
+											  std::size_t segmentBytes = 0);
+
+	/**
+	 * Number of primes up to and including n, with a segmented sieve over
+	 * the mod-30 wheel (see WheelSieve).
+	 *
+	 * Against segmentedCountPrimes(), which keeps every odd number, this
+	 * stores and scans 8 / 15 as many bits and never crosses off multiples
+	 * of 3 and 5; multiples of 7 to 17 are copied in from a pattern.
+	 *
+	 * @param segmentBytes Bytes per segment, each covering 30 numbers. Zero
+	 * picks about sqrt(n) / 30, kept between the L1 and L2 sizes.
+	 */
+	std::uint64_t wheelCountPrimes(std::uint64_t n,
+								   std::size_t segmentBytes = 0);
+
+	/**
+	 * Sieve of Eratosthenes of [0, limit] on a mod-30 wheel.
+	 *
+	 * Only the 8 residues mod 30 that are coprime to 30 (1, 7, 11, 13, 17,
+	 * 19, 23, 29) can be prime above 5, so each block of 30 numbers is one
+	 * byte with a bit per residue: 3.75 times less memory than a bit per
+	 * number and 1.875 times less than a bit per odd number.
+	 *
+	 * The sieve runs a cache-sized run of bytes at a time. Each run starts
+	 * as a copy of a precomputed pattern with the multiples of 7, 11, 13 and
+	 * 17 already cleared, which replaces the densest part of the crossing
+	 * off with a memcpy.
+	 */
+	class WheelSieve {
+	public:
+		WheelSieve() = default;
+
+		explicit WheelSieve(std::uint64_t limit);
+
+		std::uint64_t limit() const { return limit_; }
+
+		/** @pre n <= limit() */
+		bool isPrime(std::uint64_t n) const;
+
+		/** Number of primes up to and including limit(). */
+		std::uint64_t count() const;
+
+		/** The packed sieve, byte k holding 30k + { 1, 7, ..., 29 }. */
+		const std::vector<std::uint8_t>& bytes() const { return bytes_; }
+
+	private:
+		std::uint64_t limit_ = 0;
+		std::vector<std::uint8_t> bytes_;
+	};
+
+	/**
+	 * Prime-counting function pi(x), the number of primes up to and
+	 * including x, without sieving up to x.
+	 *
+	 * Uses Lucy_Hedgehog's method, which only tracks pi at the O(sqrt(x))
+	 * distinct values of floor(x / k): O(x^(3/4) / log x) time and
+	 * O(sqrt(x)) memory. pi(10^12) takes about a second and pi(10^13) a
+	 * few, where a sieve needs minutes.
+	 */
+	std::uint64_t primePi(std::uint64_t x);
+
+	/**
+	 * The primes in [first, last], generated lazily in increasing order:
+	 *
+	 *     for (std::uint64_t p : PrimeRange(1000000000000)) { ... }
+	 *
+	 * Nothing is sieved until begin(), and after that only one cache-sized
+	 * segment at a time, when iteration reaches it. Memory stays bounded by
+	 * one segment plus the base primes up to the square root of the current
+	 * position (at most 2^24 of them; beyond 2^48 each segment's candidates
+	 * are tested with isPrime() instead), however far the iteration goes.
+	 *
+	 * The iterators are input iterators: copies share one position, so the
+	 * range can be walked once per begin().
+	 */
+	class PrimeRange {
+		struct State;
+
+	public:
+		class iterator {
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = std::uint64_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const std::uint64_t*;
+			using reference = const std::uint64_t&;
+
+			iterator() = default;
+
+			const std::uint64_t& operator*() const;
+
+			iterator& operator++();
+
+			bool operator==(const iterator& other) const
+			{
+				return state_ == other.state_;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return state_ != other.state_;
+			}
+
+		private:
+			friend class PrimeRange;
+
+			std::shared_ptr<State> state_;	///< Null at the end.
+		};
+
+		explicit PrimeRange(std::uint64_t first = 0,
+							std::uint64_t last =
+								std::numeric_limits<std::uint64_t>::max())
+			: first_(first), last_(last)
+		{
+		}
+
+		/** Starts sieving at first; each call starts a new pass. */
+		iterator begin() const;
+
+		iterator end() const { return iterator(); }
+
+	private:
+		std::uint64_t first_;
+		std::uint64_t last_;
+	};
+
+	/**
+	 * Primes up to a fixed limit, sieved once, for answering many queries.
+	 *
+	 * The sieve is kept as the mod-30 wheel bitmap of WheelSieve, 8 bits
+	 * per 30 numbers, with the number of primes before every block of
+	 * BLOCK_WORDS words (one cache line) alongside: 8 more bytes per 1920
+	 * numbers. Counting the primes up to n is then a block lookup plus at
+	 * most BLOCK_WORDS popcounts, so range counts are O(1); nth() binary
+	 * searches the blocks, O(log n); next() scans forward from n, which is
+	 * bounded by the largest prime gap.
+	 *
+	 * Queries past limit() throw std::out_of_range.
+	 */
+	class PrimeIndex {
+	public:
+		/** Words per block of the prefix-count table. */
+		static constexpr std::size_t BLOCK_WORDS = 8;
+
+		PrimeIndex() = default;
+
+		explicit PrimeIndex(std::uint64_t limit);
+
+		std::uint64_t limit() const { return limit_; }
+
+		/** Number of primes up to and including limit(). */
+		std::uint64_t size() const;
+
+		bool isPrime(std::uint64_t n) const;
+
+		/** Number of primes in [a, b]. */
+		std::uint64_t count(std::uint64_t a, std::uint64_t b) const;
+
+		/** The k-th prime, counting 2 as the first. */
+		std::uint64_t nth(std::uint64_t k) const;
+
+		/** The smallest prime greater than n. */
+		std::uint64_t next(std::uint64_t n) const;
+
+		/**
+		 * Writes the bitmap, in host byte order, after a small header; the
+		 * prefix counts are rebuilt on load in one popcount pass.
+		 *
+		 * @throw std::runtime_error If the file cannot be written.
+		 */
+		void save(const std::string& path) const;
+
+		/** @throw std::runtime_error If the file is not a saved index. */
+		static PrimeIndex load(const std::string& path);
+
+	private:
+		void buildBlocks();
+
+		/** Number of set bits of the bitmap before bit. */
+		std::uint64_t rank(std::uint64_t bit) const;
+
+		/** Number of primes up to and including n. */
+		std::uint64_t countUpTo(std::uint64_t n) const;
+
+		std::uint64_t limit_ = 0;
+		std::vector<std::uint64_t> words_;
+		std::vector<std::uint64_t> blocks_ = { 0 };	///< Set bits before each block.
+	};
+
+	/**
+	 * Deterministic primality test for 64-bit n.
+	 *
+	 * Below PRIME_TABLE_LIMIT this is the O(1) isSmallPrime(). Above it,
+	 * trial division by the primes below 100 (a multiply and compare each)
+	 * settles most composites; the rest go through Miller-Rabin with the
+	 * seven witnesses known to be exact below 2^64, in Montgomery
+	 * arithmetic. At most about 450 modular multiplies, so O(log n) rather
+	 * than the O(sqrt(n)) of plain trial division.
+	 */
+	bool isPrime(std::uint64_t n);
+
+	/**
+	 * out[i] = isPrime(n[i]) for i in [0, count).
+	 *
+	 * Candidates that survive trial division are tested four at a time,
+	 * interleaved step by step, so the latency of one chain of dependent
+	 * multiplies is hidden behind the others.
+	 */
+	void isPrime(const std::uint64_t* n, std::size_t count, bool* out);
+} // namespace algo
+
+// PRIMES_HPP
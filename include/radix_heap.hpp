@@ -0,0 +1,93 @@
+/**
+ * @file radix_heap.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Monotone radix heap for integer keys.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+	/**
+	 * Min-heap for unsigned 64-bit keys that only works when keys never go
+	 * below the last key popped, which is the case in Dijkstra's algorithm.
+	 *
+	 * Bucket i holds the entries whose key first differs from the last
+	 * popped key at bit i - 1 (bucket 0 holds keys equal to it). Popping from
+	 * an empty bucket 0 takes the lowest non-empty bucket, makes its minimum
+	 * the new last key and redistributes it; every entry lands in a strictly
+	 * lower bucket, so each entry moves at most 64 times over its life and
+	 * push is O(1), pop amortized O(log C) for keys spanning C. The buckets
+	 * are plain vectors, so it is also far friendlier to the cache than a
+	 * pointer-based heap.
+	 *
+	 * @tparam Value Payload stored with each key.
+	 */
+	template <typename Value>
+	class RadixHeap {
+	public:
+		bool empty() const { return size_ == 0; }
+
+		std::size_t size() const { return size_; }
+
+		/** @pre key is not less than the last key popped. */
+		void push(std::uint64_t key, const Value& value)
+		{
+			buckets_[bucketOf(key)].emplace_back(key, value);
+			++size_;
+		}
+
+		/** Removes and returns the entry with the smallest key. @pre !empty() */
+		std::pair<std::uint64_t, Value> pop()
+		{
+			if (buckets_[0].empty()) {
+				refill();
+			}
+			std::pair<std::uint64_t, Value> top = buckets_[0].back();
+			buckets_[0].pop_back();
+			--size_;
+			return top;
+		}
+
+	private:
+		int bucketOf(std::uint64_t key) const
+		{
+			return key == last_ ? 0 : 64 - __builtin_clzll(key ^ last_);
+		}
+
+		void refill()
+		{
+			int i = 1;
+			while (buckets_[i].empty()) {
+				++i;
+			}
+			std::uint64_t least = buckets_[i].front().first;
+			for (const auto& entry : buckets_[i]) {
+				if (entry.first < least) {
+					least = entry.first;
+				}
+			}
+			last_ = least;
+			for (const auto& entry : buckets_[i]) {
+				buckets_[bucketOf(entry.first)].push_back(entry);
+			}
+			buckets_[i].clear();
+		}
+
+		std::array<std::vector<std::pair<std::uint64_t, Value>>, 65> buckets_;
+		std::uint64_t last_ = 0;
+		std::size_t size_ = 0;
+	};
+} // namespace algo
+
+// RADIX_HEAP_HPP
@@ -0,0 +1,245 @@
+/**
+ * @file sort.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Sorting algorithms for large arrays.
+ *
+ * The comparison sorts take random-access iterators, a comparator and a
+ * projection: elements x and y are ordered by comp(proj(x), proj(y)), both
+ * called through std::invoke, so a pointer to a data member sorts structs by
+ * that field. Trivially copyable elements are compared and moved without
+ * branches where that helps.
+ */
+
+#pragma once
+
+#include "task_pool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace algo {
+	/** Runs of this many elements are insertion sorted before merging. */
+	constexpr std::size_t MERGE_RUN = 32;
+
+	/** Largest size networkSort() has a network for. */
+	constexpr std::size_t NETWORK_MAX = 16;
+
+	/**
+	 * parallelMergeSort() sorts ranges of up to this many elements, and
+	 * merges outputs of up to this many, as single tasks.
+	 */
+	constexpr std::size_t PARALLEL_SORT_GRAIN = std::size_t(1) << 14;
+
+	/**
+	 * Bits per digit of radixSort(). 11 takes 32-bit keys in three passes
+	 * instead of four, and the 2048 bucket counters of a pass still fit in
+	 * L1.
+	 */
+	constexpr unsigned RADIX_BITS = 11;
+
+	/**
+	 * Projection that returns its argument unchanged, the default of the
+	 * sorts below.
+	 */
+	struct Identity {
+		template <typename T>
+		constexpr T&& operator()(T&& t) const noexcept
+		{
+			return std::forward<T>(t);
+		}
+	};
+
+	/**
+	 * Selection sort: moves the largest remaining element to the end of
+	 * the unsorted part on each pass. O(n^2) comparisons, O(n) swaps.
+	 */
+	template <typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void selectionSort(It first, It last, Compare comp = Compare(),
+					   Proj proj = Proj());
+
+	/**
+	 * Stable bubble sort that stops after a pass without swaps. O(n^2)
+	 * comparisons, O(n) on sorted input.
+	 */
+	template <typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void bubbleSort(It first, It last, Compare comp = Compare(),
+					Proj proj = Proj());
+
+	/**
+	 * Sorts the N elements at first with a sorting network chosen at
+	 * compile time: Batcher's odd-even merge network, fully unrolled, whose
+	 * compare-exchanges are branchless for trivially copyable elements.
+	 * Not stable.
+	 *
+	 * @pre N <= NETWORK_MAX.
+	 */
+	template <std::size_t N, typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void networkSort(It first, Compare comp = Compare(), Proj proj = Proj());
+
+	/** networkSort() of a whole array. */
+	template <typename T, std::size_t N, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void networkSort(std::array<T, N>& a, Compare comp = Compare(),
+					 Proj proj = Proj());
+
+	/**
+	 * Stable bottom-up merge sort.
+	 *
+	 * Runs of MERGE_RUN elements are insertion sorted in place, then merged
+	 * pairwise in passes of doubling width, each pass reading one buffer
+	 * and writing the other, so the only allocation is a single buffer of
+	 * n elements and no pass copies back. Adjacent runs that are already in
+	 * order are copied instead of merged. O(n log n) time, n extra elements
+	 * of space.
+	 *
+	 * @param comp Strict weak ordering; equal elements keep their order.
+	 *
+	 * @pre The value type is default constructible and move assignable.
+	 */
+	template <typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void bottomUpMergeSort(It first, It last, Compare comp = Compare(),
+						   Proj proj = Proj());
+
+	/** bottomUpMergeSort() of a whole vector. */
+	template <typename T, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void bottomUpMergeSort(std::vector<T>& v, Compare comp = Compare(),
+						   Proj proj = Proj());
+
+	/**
+	 * Stable parallel merge sort.
+	 *
+	 * The halves of the recursion are forked as tasks on pool down to
+	 * PARALLEL_SORT_GRAIN elements, which are sorted as in
+	 * bottomUpMergeSort(). Each merge is itself split by binary search into
+	 * independent tasks, so the top levels, where a serial merge would leave
+	 * all but one thread idle, are parallel too. O(n log n) work,
+	 * O(log^3 n) span, one buffer of n elements.
+	 *
+	 * @param comp As for bottomUpMergeSort(); it and proj are called
+	 * concurrently from several threads.
+	 *
+	 * @pre As for bottomUpMergeSort().
+	 */
+	template <typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void parallelMergeSort(It first, It last, TaskPool& pool,
+						   Compare comp = Compare(), Proj proj = Proj());
+
+	/** parallelMergeSort() of a whole vector. */
+	template <typename T, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void parallelMergeSort(std::vector<T>& v, TaskPool& pool,
+						   Compare comp = Compare(), Proj proj = Proj());
+
+	/**
+	 * Unstable in-place sort: pattern-defeating quicksort.
+	 *
+	 * Introsort at heart, with these additions:
+	 * - Pivots are the median of three, or above 128 elements a ninther.
+	 * - Trivially copyable elements are partitioned in blocks, branch
+	 *   free.
+	 * - Partitions that are highly unbalanced get a few elements swapped
+	 *   around to break the pattern. After log2(n) of them the range falls
+	 *   back to heapsort, which caps the worst case at O(n log n).
+	 * - A partition that moved nothing is taken as a hint of sorted input,
+	 *   confirmed by an insertion sort that stops after a few moves, so
+	 *   sorted runs cost O(n).
+	 * - A pivot equal to the bound below its range puts all of its copies
+	 *   in place in one pass, so k distinct values cost O(n log k).
+	 *
+	 * No allocation, O(log n) stack.
+	 *
+	 * @pre The value type is move constructible and move assignable.
+	 */
+	template <typename It, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void pdqSort(It first, It last, Compare comp = Compare(),
+				 Proj proj = Proj());
+
+	/** pdqSort() of a whole vector. */
+	template <typename T, typename Compare = std::less<>,
+			  typename Proj = Identity>
+	void pdqSort(std::vector<T>& v, Compare comp = Compare(),
+				 Proj proj = Proj());
+
+	/**
+	 * True if this host runs the AVX2 kernels that bottomUpMergeSort() and
+	 * parallelMergeSort() use for contiguous std::int32_t and std::int64_t
+	 * in ascending order: blocks sorted in registers by sorting networks,
+	 * and runs merged a vector at a time by bitonic merge networks. Other
+	 * hosts, element types and orders use the scalar code.
+	 */
+	bool simdSortSupported();
+
+	namespace detail {
+		/**
+		 * AVX2 ascending sort of data[0, n), using buffer for n more.
+		 *
+		 * @return False, having done nothing, if !simdSortSupported().
+		 */
+		bool simdMergeSort(std::int32_t* data, std::int32_t* buffer,
+						   std::size_t n);
+
+		bool simdMergeSort(std::int64_t* data, std::int64_t* buffer,
+						   std::size_t n);
+
+		/**
+		 * AVX2 merge of the ascending ranges [a, aEnd) and [b, bEnd).
+		 *
+		 * @return False, having done nothing, if !simdSortSupported().
+		 */
+		bool simdMerge(const std::int32_t* a, const std::int32_t* aEnd,
+					   const std::int32_t* b, const std::int32_t* bEnd,
+					   std::int32_t* out);
+
+		bool simdMerge(const std::int64_t* a, const std::int64_t* aEnd,
+					   const std::int64_t* b, const std::int64_t* bEnd,
+					   std::int64_t* out);
+	} // namespace detail
+
+	/**
+	 * Stable least-significant-digit radix sort of integer keys, ascending.
+	 *
+	 * One pass over the keys builds the histograms of all RADIX_BITS-bit
+	 * digits at once; each digit then takes one scatter pass into a buffer
+	 * of n keys and back, skipped if every key has the same digit there, so
+	 * keys that only use their low bits cost only as many passes as they
+	 * need. Signed keys have their sign bit flipped for the digits, which
+	 * orders negatives first. O(n * sizeof(K)) time, n extra keys of space.
+	 *
+	 * @pre K is an integral type.
+	 */
+	template <typename K>
+	void radixSort(std::vector<K>& keys);
+
+	/**
+	 * Radix sort of keys that carries values[i] along with keys[i], so the
+	 * values end up in key order and, for equal keys, in input order.
+	 *
+	 * @throw std::invalid_argument If keys and values differ in size.
+	 *
+	 * @pre As for radixSort(keys); V is default constructible and move
+	 * assignable.
+	 */
+	template <typename K, typename V>
+	void radixSort(std::vector<K>& keys, std::vector<V>& values);
+} // namespace algo
+
+// Template implementations.
+#include "sort.cpp"
+
+// SORT_HPP
@@ -0,0 +1,107 @@
+/**
+ * @file task_pool.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Work-stealing thread pool for recursive fork-join algorithms.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algo {
+	/**
+	 * A pool of size() threads for nested fork-join parallelism: size() - 1
+	 * workers plus the calling thread, which runs the root task of every
+	 * job as thread 0.
+	 *
+	 * Every thread has a deque of forked tasks. invoke() pushes its second
+	 * task onto the bottom of the caller's deque and runs the first; idle
+	 * threads steal from the top of other deques, so thieves take the
+	 * oldest, largest pieces of a recursion while the owner keeps working
+	 * depth first on the newest. A thread waiting for a stolen task runs
+	 * other tasks meanwhile instead of blocking.
+	 *
+	 * Unlike ThreadPool, work is not split up front, so a recursion with
+	 * uneven halves still keeps every thread busy.
+	 *
+	 * @note run() must not be called from inside a job; invoke() may be
+	 * called from anywhere inside one.
+	 */
+	class TaskPool {
+	public:
+		/**
+		 * @param numThreads Total number of threads, including the caller.
+		 * Zero means std::thread::hardware_concurrency().
+		 */
+		explicit TaskPool(int numThreads = 0);
+
+		~TaskPool();
+
+		TaskPool(const TaskPool&) = delete;
+
+		TaskPool& operator=(const TaskPool&) = delete;
+
+		int size() const { return static_cast<int>(queues_.size()); }
+
+		/**
+		 * Runs fn on the calling thread with the workers standing by to steal
+		 * whatever it forks, and returns once fn has. Exceptions from fn
+		 * propagate.
+		 */
+		void run(const std::function<void()>& fn);
+
+		/**
+		 * Runs a and b, possibly in parallel, and returns once both have
+		 * finished. If either throws, the other still finishes and the first
+		 * exception is rethrown. Called outside a job, it runs one.
+		 */
+		void invoke(const std::function<void()>& a,
+					const std::function<void()>& b);
+
+	private:
+		struct Task;
+
+		/** A thread's deque of forked tasks. */
+		struct Queue {
+			std::mutex mutex;
+			std::deque<Task*> tasks;
+		};
+
+		void workerLoop(int tid);
+
+		/** Runs t, keeping any exception for whoever joins it. */
+		static void execute(Task& t);
+
+		/** Pops the newest task of queue tid, or nullptr. */
+		Task* pop(int tid);
+
+		/** Steals the oldest task of some other queue, or nullptr. */
+		Task* steal(int tid);
+
+		std::vector<std::unique_ptr<Queue>> queues_;
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable start_;
+		std::condition_variable done_;
+		std::atomic<bool> active_{false};
+		std::uint64_t generation_ = 0;
+		int busy_ = 0;
+		bool stop_ = false;
+	};
+} // namespace algo
+
+// TASK_POOL_HPP
@@ -0,0 +1,77 @@
+/**
+ * @file thread_pool.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Fixed-size thread pool for the parallel algorithms.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algo {
+	/**
+	 * A pool of size() threads: size() - 1 workers plus the calling thread,
+	 * which takes part in every job as thread 0. Jobs are fork-join: run()
+	 * returns once every thread has finished, so it doubles as a barrier
+	 * between phases of a level-synchronous algorithm.
+	 *
+	 * @note run() and parallelFor() must not be called from inside a job.
+	 */
+	class ThreadPool {
+	public:
+		/**
+		 * @param numThreads Total number of threads, including the caller.
+		 * Zero means std::thread::hardware_concurrency().
+		 */
+		explicit ThreadPool(int numThreads = 0);
+
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+		/**
+		 * Calls fn(tid) once on every thread, tid in [0, size()), and waits
+		 * for all of them. The first exception thrown by fn is rethrown here.
+		 */
+		void run(const std::function<void(int)>& fn);
+
+		/**
+		 * Splits [first, last) into chunks of grain indices that threads claim
+		 * dynamically, and calls fn(tid, begin, end) for each chunk.
+		 */
+		void parallelFor(std::size_t first, std::size_t last, std::size_t grain,
+						 const std::function<void(int, std::size_t,
+												  std::size_t)>& fn);
+
+	private:
+		void workerLoop(int tid);
+
+		std::vector<std::thread> workers_;
+		std::mutex mutex_;
+		std::condition_variable start_;
+		std::condition_variable done_;
+		const std::function<void(int)>* job_ = nullptr;
+		std::uint64_t generation_ = 0;
+		int pending_ = 0;
+		bool stop_ = false;
+		std::exception_ptr error_;
+	};
+} // namespace algo
+
+// THREAD_POOL_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file union_find.hpp
+ * @namespace algo
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Disjoint-set forest (union-find).
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace algo {
+	/**
+	 * Disjoint sets over the ids [0, n) with path compression and union by
+	 * rank, so any sequence of m operations takes O(m alpha(n)) time.
+	 * https://cp-algorithms.com/data_structures/disjoint_set_union.html
+	 */
+	class UnionFind {
+	public:
+		explicit UnionFind(int n) : parent_(n), rank_(n, 0)
+		{
+			for (int i = 0; i < n; ++i) {
+				parent_[i] = i;
+			}
+		}
+
+		/** Representative of the set containing x. */
+		int find(int x)
+		{
+			int root = x;
+			while (parent_[root] != root) {
+				root = parent_[root];
+			}
+			// Point the whole path straight at the root.
+			while (parent_[x] != root) {
+				int next = parent_[x];
+				parent_[x] = root;
+				x = next;
+			}
+			return root;
+		}
+
+		/**
+		 * Merges the sets of a and b.
+		 *
+		 * @return False if they were already the same set.
+		 */
+		bool unite(int a, int b)
+		{
+			a = find(a);
+			b = find(b);
+			if (a == b) {
+				return false;
+			}
+			// Hang the shallower tree under the deeper one.
+			if (rank_[a] < rank_[b]) {
+				std::swap(a, b);
+			}
+			parent_[b] = a;
+			if (rank_[a] == rank_[b]) {
+				++rank_[a];
+			}
+			return true;
+		}
+
+		bool same(int a, int b) { return find(a) == find(b); }
+
+	private:
+		std::vector<int> parent_;
+		std::vector<int> rank_;
+	};
+} // namespace algo
+
+// UNION_FIND_HPP
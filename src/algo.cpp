@@ -95,30 +95,18 @@ bool algo::risPalindrome(const string& s)
 	return risPalindrome(s.substr(1, s.size() - 2));
 }
 
-// Using Sieve of Eratosthenes.
+// A compile-time table for small n, otherwise a segmented Sieve of
+// Eratosthenes on a mod-30 wheel, see primes.hpp.
 // https://cp-algorithms.com/algebra/sieve-of-eratosthenes.html
 int algo::countPrimes(int n)
 {
 	if (n < 2) {	// there are no primes less than two
 		return 0;
 	}
-
-	vector<bool> primes(n + 1, true);
-	primes[0] = primes[1] = false;
-	// Upcasting here because integer overflow is a concern with i^2.
-	for (long long i = 2; i * i <= n; ++i) {
-		if (primes[i]) {
-			for (auto j = i * i; j <= n; j += i) {
-	  			primes[j] = false;
-	  		}
-	  	}
+	if (static_cast<uint32_t>(n) < PRIME_TABLE_LIMIT) {
+		return smallPrimeCount(n);
 	}
-
-	// Remove all non-primes and return size.
-	primes.erase(remove_if(primes.begin(), primes.end(), [](bool v) {
-		return !v;
-	}),	primes.end());
-	return primes.size();
+	return static_cast<int>(wheelCountPrimes(n));
 }
 
 // Prim's Algorithm.
@@ -162,36 +150,21 @@ int algo::primMst(const vector<vector<int>>& adj)
 	return cost;
 }
 
-// xxx
-// Kruskal's Algorithm.
+// Kruskal's Algorithm on an adjacency matrix, where the upper triangle holds
+// the weight of each undirected edge.
 // https://cp-algorithms.com/graph/mst_kruskal.html
-//int algo::kruskalMst(const vector<vector<int>>& adj, int n)
-//{
-//	vector<pair<int, int>> edges;	// xxx convert adjacency matrix to edges
-//	int cost = 0;
-//	vector<int> treeId(n);
-//	vector<pair<int, int>> result;
-//	for (int i = 0; i < n; ++i) {
-//		treeId[i] = i;
-//	}
-//
-//	sort(edges.begin(), edges.end());
-//	for (const auto& e : edges) {
-//		if (treeId[e.first] != treeId[e.second]); {
-//	  		//cost += e.third;
-//			result.push_back(e);
-//
-//			int oldId = treeId[e.first];
-//	  		int newId = treeId[e.second];
-//	  		for (int i = 0; i < n; ++i) {
-//	  			if (treeId[i] == oldId) {
-//	  				treeId[i] == newId;
-//	  			}
-//	  		}
-//	  	}
-//	}
-//	return cost;
-//}
+int algo::kruskalMst(const vector<vector<int>>& adj, int n)
+{
+	vector<Edge> edges;
+	for (int i = 0; i < n; ++i) {
+		for (int j = i + 1; j < n; ++j) {
+			if (adj[i][j]) {
+				edges.push_back({ i, j, adj[i][j] });
+			}
+		}
+	}
+	return static_cast<int>(kruskalMst(n, edges).cost);
+}
 
 /*
  * Adjacency matrix:
@@ -270,79 +243,78 @@ vector<int> algo::rdfs(const vector<vector<int>>& adj, int root)
 	return path;
 }
 
+/**
+ * Appends the post-order of the vertices reachable from root to path. The
+ * recursion is kept on an explicit stack of { vertex, next column } frames,
+ * so long paths cannot overflow the call stack.
+ */
 void algo::rdfsHelper(const vector<vector<int>>& adj, int root, 
 					  vector<bool>& visited, vector<int>& path)
 {
+	const int n = adj.size();
+	vector<pair<int, int>> s;
 	visited[root] = true;	// mark the current node as visited
-	for (auto i = 0; i < adj.size(); ++i) {
-		if (adj[root][i] && !visited[i]) {
-	  		rdfsHelper(adj, i, visited, path);
+	s.emplace_back(root, 0);
+	while (!s.empty()) {
+		int v = s.back().first;
+		int& i = s.back().second;
+		while (i < n && !(adj[v][i] && !visited[i])) {
+			++i;
+		}
+		if (i == n) {
+			path.push_back(v);	// post-order traversal
+			s.pop_back();
+			continue;
 		}
+		visited[i] = true;
+		s.emplace_back(i++, 0);
 	}
-	path.push_back(root);	// post-order traversal
 }
 
-// xxx
-// Dijkstra's algorithm.
-//int algo::shortestPath(const vector<vector<int>>& adj, int root)
-//{
-//	const int INF = 0x7fffffff;
-//	vector<bool> visited(adj.size(), false);
-//	vector<int> dist(adj.size(), INF);
-//	vector<int> path(adj.size(), -1);
-//	
-//	dist[root] = 0;
-//	for (int i = 0; i < adj.size(); ++i) {
-//		int v = -1;
-//		for (int j = 0; j < adj.size(); ++j) {
-//	  		if (!visited[j] && (v == -1 || dist[j] < dist[v])) {
-//	  			v = j;
-//	  		}
-//		}
-//
-//		if (dist[v] == INF) {
-//	  		// If the remaining edges are infinite, we've found the shortest 
-//	  		// path.
-//	  		break;
-//		}
-//
-//		visited[v] = true;
-//		for (const auto& e : adj[v]) {
-//			// xxx pair
-//	  		int to = e.first;
-//	  		int len = e.second;
-//			
-//	  		if (dist[v] + len < dist[t]) {
-//	  			dist[to] = dist[v] + len;
-//	  			path[to] = v;
-//	  		}
-//		}
-//	}
-//	return -1;
-//}
-
-void algo::rdfsTimed(const vector<vector<int>>& adj, int root)
+// Dijkstra's algorithm on an adjacency matrix, where a non-zero cell is the
+// weight of a directed edge.
+ShortestPaths algo::shortestPath(const vector<vector<int>>& adj, int root)
+{
+	return dijkstra(CsrGraph::fromMatrix(adj, true), root);
+}
+
+// Depth-first search with discovery and finish times.
+DfsResult algo::rdfsTimed(const vector<vector<int>>& adj, int root)
 {
-	vector<int> color(adj.size(), -1);
-	int timer = 0;
-	vector<int> inTime;
-	vector<int> outTime;
-	rdfsTimedHelper(adj, root, color, timer, inTime, outTime);
+	return depthFirstSearch(CsrGraph::fromMatrix(adj), root);
 }
 
+/**
+ * Timestamps the vertices reachable from root: 0 (or -1) is unvisited, 1 is
+ * on the stack, and 2 is finished.
+ *
+ * @pre color, inTime and outTime have one entry per vertex.
+ */
 void algo::rdfsTimedHelper(const vector<vector<int>>& adj, int root,
 						   vector<int>& color, int& timer, 
 						   vector<int>& inTime, vector<int>& outTime)
 {
-	inTime[root] == timer++;
+	const int n = adj.size();
+	vector<pair<int, int>> s;
+	inTime[root] = timer++;
 	color[root] = 1;
-	for (int v : adj[root]) {
-		if (color[root] < 1) {
-	  		rdfsTimedHelper(adj, v, color, timer, inTime, outTime);
-	  	}
+	s.emplace_back(root, 0);
+	while (!s.empty()) {
+		int v = s.back().first;
+		int& i = s.back().second;
+		while (i < n && !(adj[v][i] && color[i] < 1)) {
+			++i;
+		}
+		if (i == n) {
+			color[v] = 2;
+			outTime[v] = timer++;
+			s.pop_back();
+			continue;
+		}
+		inTime[i] = timer++;
+		color[i] = 1;
+		s.emplace_back(i++, 0);
 	}
-	color[root] = 2;
-	outTime[root] = timer++;
 }
 
 /**
@@ -384,22 +356,13 @@ vector<vector<char>> algo::rotateMatrixClockwise(
 	return myMat;
 }
 
+// The generic versions are in sort.hpp.
 bool algo::selectionSort(vector<int>& v)
 {
 	if (v.size() < 1) {
 		return false;
 	}
-
-	for (auto i = v.size() - 1; i > 0; --i) {
-		size_t largest = 0;
-		// Don't loop what we've already sorted; all sorted is at end.
-		for (auto j = 1; j <= i; ++j) {
-	  		if (v.at(j) > v.at(largest)) {
-	  			largest = j;
-	  		}
-		}
-		swap(v.at(largest), v.at(i));
-	}
+	selectionSort(v.begin(), v.end());
 	return true;
 }
 
@@ -489,30 +452,16 @@ bool algo::bubbleSort(vector<int>& v)
 	if (v.size() < 1) {
 	   return false;
 	}
-
-	bool sorted = false;
-	size_t pass = 1;
-	while (!sorted && (pass < v.size())) {
-		sorted = true; // Assume sorted.
-		for (auto i = 0; i < v.size() - pass; ++i) {
-			auto next = i + 1;
-			if (v.at(i) > v.at(next)) {
-	   			swap(v.at(i), v.at(next));
-	   			sorted = false; // Not finished sorting, flag another pass.
-			}
-		}
-		++pass;
-	}
+	bubbleSort(v.begin(), v.end());
 	return true;
 }
 
+// Bottom-up with a single buffer, see sort.hpp; mergeSortHelper() is the
+// textbook recursion, which allocates a full-size buffer per merge.
 bool algo::mergeSort(vector<int>& v)
 {
-	const int size = v.size();
-	if (size < 1) {
-		return false;
-	}
-	return mergeSortHelper(v, size, 0, size - 1);
+	bottomUpMergeSort(v);
+	return v.size() > 1;
 }
 
 /**
@@ -584,23 +533,9 @@ void algo::merge(vector<int>& v, int size, int first, int mid, int last)
 	}
 }
 
+// Table lookup, or trial division and Miller-Rabin, see primes.hpp.
 bool algo::isPrime(int n) {
-	if (n <= 1) {
-		return false;
-	}
-	if (n == 2 || n == 3) {
-		return true;
-	}
-	// Every prime number is 6k + 1 or 6k - 1, except 2 and 3.
-	if ((n - 1) % 6 != 0 && (n + 1) % 6 != 0) {
-		return false;
-	}
-	for (long long i = 5; i * i <= n; i += 6) {	// int can overflow
-		if (n % i == 0 || n % (i + 2) == 0) {
-			return false;
-		}
-	}
-	return true;
+	return n > 1 && isPrime(static_cast<uint64_t>(n));
 }
 
 void algo::swapInt(int a, int b)
@@ -0,0 +1,552 @@
+/**
+ * @file bench.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Benchmarks for the algorithms, kept out of ctest because they take a while.
+ *
+ * Usage: algorithms_bench [--threads N] [--scale S] [name ...]
+ * 	--threads	Largest thread count to measure (default: all cores).
+ * 	--scale		Problem size knob, graphs get 2^scale vertices (default 20)
+ * 			prime counts go up to 2^(scale + 10) and sorts take
+ * 			2^(scale + 3) elements.
+ * 	name		Benchmarks to run (default: all of them).
+ */
+
+#include "algo.hpp"
+#include "task_pool.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+
+using namespace std;
+
+namespace {
+	struct Options {
+		int threads = max(1u, thread::hardware_concurrency());
+		int scale = 20;
+	};
+
+	Options options;
+
+	using Clock = chrono::steady_clock;
+
+	double secondsSince(Clock::time_point start)
+	{
+		return chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	/**
+	 * Uniform random undirected graph with 2^scale vertices and
+	 * edgeFactor * 2^scale edges (Erdos-Renyi style, low diameter).
+	 */
+	CsrGraph randomGraph(int scale, int edgeFactor, unsigned seed)
+	{
+		const int n = 1 << scale;
+		mt19937_64 rng(seed);
+		uniform_int_distribution<int> pick(0, n - 1);
+		vector<pair<int, int>> edges(static_cast<size_t>(n) * edgeFactor);
+		for (auto& e : edges) {
+			e = { pick(rng), pick(rng) };
+		}
+		return CsrGraph::fromEdges(n, edges, false);
+	}
+
+	/**
+	 * Traversed edges per second of parallelBfs for 1 to options.threads
+	 * threads, over the same set of roots. Every stored edge of a reached
+	 * vertex counts, halved because undirected edges are stored twice.
+	 */
+	void benchBfs()
+	{
+		const CsrGraph g = randomGraph(options.scale, 16, 1);
+		printf("bfs: %d vertices, %llu edges\n", g.numVertices(),
+			   static_cast<unsigned long long>(g.numEdges() / 2));
+
+		const int roots = 8;
+		mt19937 rng(2);
+		vector<int> sources(roots);
+		for (int& s : sources) {
+			do {
+				s = rng() % g.numVertices();
+			} while (g.degree(s) == 0);
+		}
+
+		printf("%8s %12s %12s %8s\n", "threads", "time (ms)", "MTEPS", "speedup");
+		double base = 0;
+		for (int t = 1; t <= options.threads; t = t < options.threads
+				 ? min(t * 2, options.threads) : t + 1) {
+			ThreadPool pool(t);
+			uint64_t edges = 0;
+			auto start = Clock::now();
+			for (int s : sources) {
+				BfsResult r = parallelBfs(g, s, pool);
+				for (int v : r.path) {
+					edges += g.degree(v);
+				}
+			}
+			double time = secondsSince(start);
+			double teps = edges / 2 / time;
+			if (t == 1) {
+				base = teps;
+			}
+			printf("%8d %12.2f %12.2f %7.2fx\n", t, time * 1e3 / roots,
+				   teps / 1e6, teps / base);
+		}
+
+		// Sequential references on the same roots.
+		auto start = Clock::now();
+		for (int s : sources) {
+			bfs(g, s);
+		}
+		printf("%8s %12.2f\n", "bfs", secondsSince(start) * 1e3 / roots);
+		start = Clock::now();
+		for (int s : sources) {
+			directionOptimizingBfs(g, s);
+		}
+		printf("%8s %12.2f\n", "diropt", secondsSince(start) * 1e3 / roots);
+	}
+
+	/**
+	 * Random weighted edge list on 2^scale vertices, each undirected edge
+	 * listed once.
+	 */
+	vector<Edge> randomEdges(int scale, int edgeFactor, unsigned seed)
+	{
+		const int n = 1 << scale;
+		mt19937_64 rng(seed);
+		uniform_int_distribution<int> pick(0, n - 1);
+		uniform_int_distribution<int> weight(1, 1 << 20);
+		vector<Edge> edges(static_cast<size_t>(n) * edgeFactor);
+		for (auto& e : edges) {
+			e = { pick(rng), pick(rng), weight(rng) };
+		}
+		return edges;
+	}
+
+	/**
+	 * Minimum spanning tree algorithms on the same random graph. The dense
+	 * primMst only runs when the adjacency matrix fits in a few MB.
+	 */
+	void benchMst()
+	{
+		const int n = 1 << options.scale;
+		const vector<Edge> edges = randomEdges(options.scale, 8, 3);
+		printf("mst: %d vertices, %zu edges\n", n, edges.size());
+		printf("%-16s %12s %16s\n", "algorithm", "time (ms)", "cost");
+
+		auto report = [](const char* name, double time, long long cost) {
+			printf("%-16s %12.2f %16lld\n", name, time * 1e3, cost);
+		};
+
+		if (n <= 1 << 12) {
+			vector<vector<int>> adj(n, vector<int>(n, 0));
+			for (const auto& e : edges) {
+				if (e.from != e.to && (!adj[e.from][e.to]
+						|| e.weight < adj[e.from][e.to])) {
+					adj[e.from][e.to] = adj[e.to][e.from] = e.weight;
+				}
+			}
+			auto start = Clock::now();
+			int cost = primMst(adj);
+			report("primMst matrix", secondsSince(start), cost);
+		}
+
+		auto start = Clock::now();
+		const CsrGraph g = CsrGraph::fromEdges(n, edges, false);
+		report("build csr", secondsSince(start), 0);
+
+		start = Clock::now();
+		int cost = primMst(g);
+		report("primMst csr", secondsSince(start), cost);
+
+		start = Clock::now();
+		MstResult r = primMsf(g);
+		report("primMsf", secondsSince(start), r.cost);
+
+		start = Clock::now();
+		r = kruskalMst(n, edges);
+		report("kruskalMst", secondsSince(start), r.cost);
+
+		for (int t = 1; t <= options.threads; t = t < options.threads
+				 ? min(t * 2, options.threads) : t + 1) {
+			ThreadPool pool(t);
+			start = Clock::now();
+			r = boruvkaMst(n, edges, pool);
+			string name = "boruvkaMst x" + to_string(t);
+			report(name.c_str(), secondsSince(start), r.cost);
+		}
+	}
+
+	/**
+	 * Road-network-like graph: a 2D grid of about 2^scale vertices with
+	 * random positive weights on the four neighbor edges, so it has a large
+	 * diameter and low degree.
+	 */
+	CsrGraph gridGraph(int scale, unsigned seed)
+	{
+		const int side = 1 << (scale / 2);
+		const int n = side * side;
+		mt19937 rng(seed);
+		uniform_int_distribution<int> weight(1, 1000);
+		vector<Edge> edges;
+		edges.reserve(2 * static_cast<size_t>(n));
+		for (int y = 0; y < side; ++y) {
+			for (int x = 0; x < side; ++x) {
+				int v = y * side + x;
+				if (x + 1 < side) {
+					edges.push_back({ v, v + 1, weight(rng) });
+				}
+				if (y + 1 < side) {
+					edges.push_back({ v, v + side, weight(rng) });
+				}
+			}
+		}
+		return CsrGraph::fromEdges(n, edges, false);
+	}
+
+	/**
+	 * Single-source shortest paths from a corner of the grid: Dijkstra, then
+	 * delta-stepping with the default delta for 1 to options.threads
+	 * threads.
+	 */
+	void benchSssp()
+	{
+		const CsrGraph g = gridGraph(options.scale, 4);
+		printf("sssp: %d vertices, %llu edges\n", g.numVertices(),
+			   static_cast<unsigned long long>(g.numEdges() / 2));
+		printf("%-18s %12s %16s\n", "algorithm", "time (ms)", "farthest");
+
+		auto report = [](const char* name, double time,
+						 const ShortestPaths& r) {
+			printf("%-18s %12.2f %16lld\n", name, time * 1e3,
+				   static_cast<long long>(*max_element(r.dist.begin(),
+													   r.dist.end())));
+		};
+
+		auto start = Clock::now();
+		ShortestPaths r = dijkstra(g, 0);
+		report("dijkstra", secondsSince(start), r);
+
+		for (int t = 1; t <= options.threads; t = t < options.threads
+				 ? min(t * 2, options.threads) : t + 1) {
+			ThreadPool pool(t);
+			start = Clock::now();
+			r = deltaStepping(g, 0, pool);
+			string name = "deltaStepping x" + to_string(t);
+			report(name.c_str(), secondsSince(start), r);
+		}
+	}
+
+	/**
+	 * Prime counting up to 2^(scale + 10): the sequential segmented sieves,
+	 * the sublinear primePi(), then the parallel sieve for 1 to
+	 * options.threads threads. Speedups are against segmentedCountPrimes().
+	 */
+	void benchPrimes()
+	{
+		const uint64_t n = uint64_t(1) << min(options.scale + 10, 62);
+		printf("primes: n = %llu\n", static_cast<unsigned long long>(n));
+		printf("%-22s %12s %16s %8s\n", "algorithm", "time (ms)", "count",
+			   "speedup");
+
+		auto start = Clock::now();
+		uint64_t count = segmentedCountPrimes(n);
+		double base = secondsSince(start);
+		printf("%-22s %12.2f %16llu\n", "segmentedCountPrimes", base * 1e3,
+			   static_cast<unsigned long long>(count));
+
+		start = Clock::now();
+		count = wheelCountPrimes(n);
+		double time = secondsSince(start);
+		printf("%-22s %12.2f %16llu %7.2fx\n", "wheelCountPrimes", time * 1e3,
+			   static_cast<unsigned long long>(count), base / time);
+
+		start = Clock::now();
+		count = primePi(n);
+		time = secondsSince(start);
+		printf("%-22s %12.2f %16llu %7.2fx\n", "primePi", time * 1e3,
+			   static_cast<unsigned long long>(count), base / time);
+
+		for (int t = 1; t <= options.threads; t = t < options.threads
+				 ? min(t * 2, options.threads) : t + 1) {
+			ThreadPool pool(t);
+			start = Clock::now();
+			count = parallelCountPrimes(n, pool);
+			time = secondsSince(start);
+			string name = "parallelCountPrimes x" + to_string(t);
+			printf("%-22s %12.2f %16llu %7.2fx\n", name.c_str(), time * 1e3,
+				   static_cast<unsigned long long>(count), base / time);
+		}
+	}
+
+	/**
+	 * Primality tests on 2^scale random odd 64-bit candidates: one at a
+	 * time, then through the interleaved batch form.
+	 */
+	void benchIsPrime()
+	{
+		vector<uint64_t> n(size_t(1) << options.scale);
+		mt19937_64 rng(5);
+		for (auto& x : n) {
+			x = rng() | 1;
+		}
+		printf("isprime: %zu candidates\n", n.size());
+		printf("%-16s %12s %16s %12s\n", "algorithm", "time (ms)", "primes",
+			   "M/s");
+
+		auto report = [&](const char* name, double time, size_t primes) {
+			printf("%-16s %12.2f %16zu %12.2f\n", name, time * 1e3, primes,
+				   n.size() / time / 1e6);
+		};
+
+		auto start = Clock::now();
+		size_t primes = 0;
+		for (uint64_t x : n) {
+			primes += isPrime(x);
+		}
+		report("isPrime", secondsSince(start), primes);
+
+		unique_ptr<bool[]> out(new bool[n.size()]);
+		start = Clock::now();
+		isPrime(n.data(), n.size(), out.get());
+		double time = secondsSince(start);
+		report("isPrime batch", time, count(out.get(), out.get() + n.size(),
+											true));
+	}
+
+	/** 2^(scale + 3) random ints, a bit under 10^7 at the default scale. */
+	vector<int> randomInts(int scale, unsigned seed)
+	{
+		vector<int> v(size_t(1) << (scale + 3));
+		mt19937 rng(seed);
+		for (int& x : v) {
+			x = static_cast<int>(rng());
+		}
+		return v;
+	}
+
+	/**
+	 * Sorts of the same random ints. The textbook recursive merge sort
+	 * allocates a full-size buffer per merge, so it only runs on a 2^16
+	 * element prefix, reported next to bottomUpMergeSort on the same. The
+	 * last two rows sort the ints in independent blocks of 16.
+	 */
+	void benchSort()
+	{
+		const vector<int> input = randomInts(options.scale, 6);
+		printf("sort: %zu ints, simd %s\n", input.size(),
+			   simdSortSupported() ? "on" : "off");
+		printf("%-24s %12s %12s\n", "algorithm", "time (ms)", "Melem/s");
+
+		auto run = [&](const char* name, size_t n, void (*sort)(vector<int>&)) {
+			vector<int> v(input.begin(), input.begin() + n);
+			auto start = Clock::now();
+			sort(v);
+			double time = secondsSince(start);
+			if (!is_sorted(v.begin(), v.end())) {
+				printf("%s: not sorted\n", name);
+			}
+			printf("%-24s %12.2f %12.2f\n", name, time * 1e3, n / time / 1e6);
+		};
+
+		const size_t small = min<size_t>(input.size(), 1 << 16);
+		run("mergeSortHelper 2^16", small, [](vector<int>& v) {
+			mergeSortHelper(v, v.size(), 0, v.size() - 1);
+		});
+		run("bottomUpMergeSort 2^16", small, [](vector<int>& v) {
+			bottomUpMergeSort(v);
+		});
+
+		const size_t n = input.size();
+		run("std::sort", n, [](vector<int>& v) {
+			sort(v.begin(), v.end());
+		});
+		run("pdqSort", n, [](vector<int>& v) {
+			pdqSort(v);
+		});
+		run("std::stable_sort", n, [](vector<int>& v) {
+			stable_sort(v.begin(), v.end());
+		});
+		run("bottomUpMergeSort", n, [](vector<int>& v) {
+			bottomUpMergeSort(v);
+		});
+		// A comparator of its own keeps it off the simd kernels.
+		run("bottomUpMergeSort scalar", n, [](vector<int>& v) {
+			bottomUpMergeSort(v, [](int a, int b) { return a < b; });
+		});
+		run("radixSort", n, [](vector<int>& v) {
+			radixSort(v);
+		});
+
+		// Many tiny sorts, each block of 16 on its own.
+		auto blocks = [&](const char* name, void (*sort16)(int*)) {
+			vector<int> v(input.begin(), input.begin() + (n & ~size_t(15)));
+			auto start = Clock::now();
+			for (size_t i = 0; i < v.size(); i += 16) {
+				sort16(&v[i]);
+			}
+			double time = secondsSince(start);
+			for (size_t i = 0; i < v.size(); i += 16) {
+				if (!is_sorted(&v[i], &v[i] + 16)) {
+					printf("%s: not sorted\n", name);
+					break;
+				}
+			}
+			printf("%-24s %12.2f %12.2f\n", name, time * 1e3,
+				   v.size() / time / 1e6);
+		};
+		blocks("std::sort x16", [](int* p) { sort(p, p + 16); });
+		blocks("networkSort<16>", [](int* p) { networkSort<16>(p); });
+	}
+
+	/**
+	 * parallelMergeSort for 1 to options.threads threads on 2^(scale + 3)
+	 * ints in four distributions: random, already sorted, reversed and
+	 * random over 16 distinct values. Speedups are against
+	 * bottomUpMergeSort on the same input.
+	 */
+	void benchParallelSort()
+	{
+		const vector<int> random = randomInts(options.scale, 7);
+		vector<int> sorted = random;
+		sort(sorted.begin(), sorted.end());
+		const vector<int> reversed(sorted.rbegin(), sorted.rend());
+		vector<int> few = random;
+		for (int& x : few) {
+			x &= 15;
+		}
+		const pair<const char*, const vector<int>*> inputs[] = {
+			{ "random", &random }, { "sorted", &sorted },
+			{ "reversed", &reversed }, { "16 values", &few },
+		};
+
+		printf("psort: %zu ints\n", random.size());
+		printf("%-10s %-24s %12s %8s\n", "input", "algorithm", "time (ms)",
+			   "speedup");
+		for (const auto& input : inputs) {
+			vector<int> v = *input.second;
+			auto start = Clock::now();
+			bottomUpMergeSort(v);
+			double base = secondsSince(start);
+			printf("%-10s %-24s %12.2f\n", input.first, "bottomUpMergeSort",
+				   base * 1e3);
+
+			for (int t = 1; t <= options.threads; t = t < options.threads
+					 ? min(t * 2, options.threads) : t + 1) {
+				TaskPool pool(t);
+				v = *input.second;
+				start = Clock::now();
+				parallelMergeSort(v, pool);
+				double time = secondsSince(start);
+				if (!is_sorted(v.begin(), v.end())) {
+					printf("parallelMergeSort: not sorted\n");
+				}
+				string name = "parallelMergeSort x" + to_string(t);
+				printf("%-10s %-24s %12.2f %7.2fx\n", input.first, name.c_str(),
+					   time * 1e3, base / time);
+			}
+		}
+	}
+
+	/**
+	 * externalSort of 2^(scale + 3) random ints from a file in $TMPDIR or
+	 * /tmp to another, with an eighth of the data as the memory budget so
+	 * it takes several runs, with and without background I/O. The page
+	 * cache likely holds the files, so this measures the sort more than
+	 * the disk.
+	 */
+	void benchExternalSort()
+	{
+		const vector<int> input = randomInts(options.scale, 8);
+		const char* tmp = getenv("TMPDIR");
+		const string dir = tmp && *tmp ? tmp : "/tmp";
+		const string in = dir + "/algo-bench-unsorted.bin";
+		const string out = dir + "/algo-bench-sorted.bin";
+		{
+			unique_ptr<FILE, int (*)(FILE*)> file(fopen(in.c_str(), "wb"),
+												  fclose);
+			if (!file || fwrite(input.data(), sizeof(int), input.size(),
+								file.get()) != input.size()) {
+				printf("extsort: cannot write %s\n", in.c_str());
+				return;
+			}
+		}
+
+		const size_t bytes = input.size() * sizeof(int);
+		printf("extsort: %zu ints, %zu MB budget\n", input.size(),
+			   (bytes / 8) >> 20);
+		printf("%-16s %12s %8s %8s %12s\n", "algorithm", "time (ms)", "runs",
+			   "passes", "MB/s");
+		for (bool overlap : {false, true}) {
+			ExternalSortOptions opts;
+			opts.memoryBytes = max(bytes / 8, EXTERNAL_SORT_MIN_MEMORY);
+			opts.overlapIo = overlap;
+			auto start = Clock::now();
+			ExternalSortStats stats = externalSort<int32_t>(in, out, opts);
+			double time = secondsSince(start);
+			printf("%-16s %12.2f %8llu %8d %12.2f\n",
+				   overlap ? "overlapped I/O" : "sequential I/O", time * 1e3,
+				   static_cast<unsigned long long>(stats.runs),
+				   stats.mergePasses, bytes / time / 1e6);
+		}
+		remove(in.c_str());
+		remove(out.c_str());
+	}
+
+	struct Benchmark {
+		const char* name;
+		void (*run)();
+	};
+
+	const Benchmark benchmarks[] = {
+		{ "bfs", benchBfs },
+		{ "mst", benchMst },
+		{ "sssp", benchSssp },
+		{ "primes", benchPrimes },
+		{ "isprime", benchIsPrime },
+		{ "sort", benchSort },
+		{ "psort", benchParallelSort },
+		{ "extsort", benchExternalSort },
+	};
+} // namespace
+
+int main(int argc, char** argv)
+{
+	vector<string> names;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			options.threads = max(1, atoi(argv[++i]));
+		} else if (!strcmp(argv[i], "--scale") && i + 1 < argc) {
+			options.scale = max(1, atoi(argv[++i]));
+		} else {
+			names.push_back(argv[i]);
+		}
+	}
+
+	for (const auto& b : benchmarks) {
+		if (names.empty() || find(names.begin(), names.end(), b.name)
+				!= names.end()) {
+			b.run();
+			printf("\n");
+		}
+	}
+	return 0;
+}
+
+// EOF
@@ -0,0 +1,225 @@
+/**
+ * @file bit_matrix.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the bit-packed adjacency matrix and its traversals.
+ */
+
+#include "bit_matrix.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using namespace algo;
+
+using namespace std;
+
+constexpr size_t algo::BitMatrix::LINE_WORDS;
+
+algo::BitMatrix::BitMatrix(int n)
+	: n_(n),
+	  stride_((static_cast<size_t>(n) + 64 * LINE_WORDS - 1) / (64 * LINE_WORDS)
+			  * LINE_WORDS),
+	  words_(static_cast<size_t>(n) * stride_, 0)
+{
+}
+
+BitMatrix algo::BitMatrix::fromMatrix(const vector<vector<int>>& adj)
+{
+	const int n = adj.size();
+	BitMatrix m(n);
+	for (int r = 0; r < n; ++r) {
+		for (int c = 0; c < n; ++c) {
+			if (adj[r][c]) {
+				m.set(r, c);
+			}
+		}
+	}
+	return m;
+}
+
+uint64_t algo::BitMatrix::numEdges() const
+{
+	uint64_t count = 0;
+	for (uint64_t w : words_) {
+		count += __builtin_popcountll(w);
+	}
+	return count;
+}
+
+namespace {
+	using Words = BitMatrix::Words;
+
+	/**
+	 * out = row & ~visited, a cache line at a time.
+	 *
+	 * @pre All three are 64-byte aligned and words is a multiple of
+	 * BitMatrix::LINE_WORDS.
+	 *
+	 * @return True if out has any bit set.
+	 */
+	bool unvisited(const uint64_t* row, const uint64_t* visited, uint64_t* out,
+				   size_t words)
+	{
+#if defined(__AVX2__)
+		__m256i any = _mm256_setzero_si256();
+		for (size_t i = 0; i < words; i += 4) {
+			__m256i r = _mm256_load_si256(
+				reinterpret_cast<const __m256i*>(row + i));
+			__m256i v = _mm256_load_si256(
+				reinterpret_cast<const __m256i*>(visited + i));
+			__m256i m = _mm256_andnot_si256(v, r);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(out + i), m);
+			any = _mm256_or_si256(any, m);
+		}
+		return !_mm256_testz_si256(any, any);
+#elif defined(__SSE2__)
+		__m128i any = _mm_setzero_si128();
+		for (size_t i = 0; i < words; i += 2) {
+			__m128i r = _mm_load_si128(reinterpret_cast<const __m128i*>(row + i));
+			__m128i v = _mm_load_si128(
+				reinterpret_cast<const __m128i*>(visited + i));
+			__m128i m = _mm_andnot_si128(v, r);
+			_mm_store_si128(reinterpret_cast<__m128i*>(out + i), m);
+			any = _mm_or_si128(any, m);
+		}
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128()))
+			!= 0xffff;
+#else
+		uint64_t any = 0;
+		for (size_t i = 0; i < words; ++i) {
+			out[i] = row[i] & ~visited[i];
+			any |= out[i];
+		}
+		return any != 0;
+#endif
+	}
+
+	/**
+	 * visited |= mask, a cache line at a time.
+	 *
+	 * @pre As for unvisited().
+	 */
+	void markVisited(uint64_t* visited, const uint64_t* mask, size_t words)
+	{
+#if defined(__AVX2__)
+		for (size_t i = 0; i < words; i += 4) {
+			__m256i* v = reinterpret_cast<__m256i*>(visited + i);
+			__m256i m = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask + i));
+			_mm256_store_si256(v, _mm256_or_si256(_mm256_load_si256(v), m));
+		}
+#elif defined(__SSE2__)
+		for (size_t i = 0; i < words; i += 2) {
+			__m128i* v = reinterpret_cast<__m128i*>(visited + i);
+			__m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(mask + i));
+			_mm_store_si128(v, _mm_or_si128(_mm_load_si128(v), m));
+		}
+#else
+		for (size_t i = 0; i < words; ++i) {
+			visited[i] |= mask[i];
+		}
+#endif
+	}
+} // namespace
+
+// Breadth-first search: each expansion finds all unvisited neighbors with
+// one row & ~visited pass and walks the set bits in increasing order.
+vector<int> algo::bfs(const BitMatrix& adj, int root)
+{
+	const size_t words = adj.rowWords();
+	Words visited(words, 0);
+	Words found(words, 0);
+	vector<int> path;
+	path.push_back(root);
+	visited[root >> 6] |= uint64_t(1) << (root & 63);
+
+	for (size_t head = 0; head < path.size(); ++head) {
+		if (!unvisited(adj.row(path[head]), visited.data(), found.data(),
+					   words)) {
+			continue;
+		}
+		markVisited(visited.data(), found.data(), words);
+		for (size_t w = 0; w < words; ++w) {
+			for (uint64_t bits = found[w]; bits; bits &= bits - 1) {
+				path.push_back(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+			}
+		}
+	}
+	return path;
+}
+
+// Iterative depth-first search with the same visit-on-push order as the
+// matrix version: neighbors are pushed from the highest down, so the lowest
+// is expanded first.
+vector<int> algo::dfs(const BitMatrix& adj, int root)
+{
+	const size_t words = adj.rowWords();
+	Words visited(words, 0);
+	Words found(words, 0);
+	vector<int> path;
+	vector<int> s;
+	s.push_back(root);
+	visited[root >> 6] |= uint64_t(1) << (root & 63);
+
+	while (!s.empty()) {
+		int v = s.back();
+		s.pop_back();
+		path.push_back(v);
+
+		if (!unvisited(adj.row(v), visited.data(), found.data(), words)) {
+			continue;
+		}
+		markVisited(visited.data(), found.data(), words);
+		for (size_t w = words; w-- > 0; ) {
+			for (uint64_t bits = found[w]; bits; ) {
+				int bit = 63 - __builtin_clzll(bits);
+				bits &= ~(uint64_t(1) << bit);
+				s.push_back(static_cast<int>(w * 64 + bit));
+			}
+		}
+	}
+	return path;
+}
+
+// Post-order depth-first search on an explicit stack of { vertex, word }
+// frames. Already visited neighbors are masked out of each word as it is
+// read, so a frame only has to remember which word to resume from.
+vector<int> algo::rdfs(const BitMatrix& adj, int root)
+{
+	const size_t words = adj.rowWords();
+	Words visited(words, 0);
+	vector<int> path;
+	vector<pair<int, size_t>> s;
+	s.emplace_back(root, 0);
+	visited[root >> 6] |= uint64_t(1) << (root & 63);
+
+	while (!s.empty()) {
+		int v = s.back().first;
+		size_t& w = s.back().second;
+		const uint64_t* row = adj.row(v);
+		uint64_t bits = 0;
+		while (w < words && !(bits = row[w] & ~visited[w])) {
+			++w;
+		}
+		if (w == words) {
+			path.push_back(v);	// post-order traversal
+			s.pop_back();
+			continue;
+		}
+		int u = static_cast<int>(w * 64 + __builtin_ctzll(bits));
+		visited[u >> 6] |= uint64_t(1) << (u & 63);
+		s.emplace_back(u, 0);
+	}
+	return path;
+}
+
+// EOF
@@ -0,0 +1,476 @@
+/**
+ * @file external_sort.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the external merge sort.
+ */
+
+#include "external_sort.hpp"
+#include "sort.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace algo;
+
+using namespace std;
+
+namespace {
+	/** Smallest read buffer a run gets in a merge, which bounds the fan-in. */
+	constexpr size_t MIN_BLOCK_BYTES = size_t(4) << 10;
+
+	[[noreturn]] void fail(const string& path, const string& what)
+	{
+		throw runtime_error(path + ": " + what);
+	}
+
+	[[noreturn]] void failErrno(const string& path, const char* call)
+	{
+		fail(path, string(call) + ": " + strerror(errno));
+	}
+
+	/** An open file, closed on destruction. */
+	class File {
+	public:
+		File(const string& path, int flags)
+			: path_(path), fd_(open(path.c_str(), flags | O_CLOEXEC, 0644))
+		{
+			if (fd_ < 0) {
+				failErrno(path_, "open");
+			}
+		}
+
+		/**
+		 * A new file in dir for reading and writing, unlinked at once so it
+		 * disappears with its descriptor.
+		 */
+		static unique_ptr<File> temporary(const string& dir)
+		{
+			string name = dir + "/algo-sort-XXXXXX";
+			int fd = mkstemp(&name[0]);
+			if (fd < 0) {
+				failErrno(name, "mkstemp");
+			}
+			unlink(name.c_str());
+			return unique_ptr<File>(new File(fd, name));
+		}
+
+		File(const File&) = delete;
+
+		File& operator=(const File&) = delete;
+
+		~File()
+		{
+			if (fd_ >= 0) {
+				::close(fd_);
+			}
+		}
+
+		uint64_t size() const
+		{
+			struct stat st;
+			if (fstat(fd_, &st) != 0) {
+				failErrno(path_, "fstat");
+			}
+			return st.st_size;
+		}
+
+		/** Reads up to bytes from the current position; fewer only at EOF. */
+		size_t read(void* data, size_t bytes)
+		{
+			char* p = static_cast<char*>(data);
+			size_t done = 0;
+			while (done < bytes) {
+				ssize_t got = ::read(fd_, p + done, bytes - done);
+				if (got < 0 && errno == EINTR) {
+					continue;
+				}
+				if (got < 0) {
+					failErrno(path_, "read");
+				}
+				if (got == 0) {
+					break;
+				}
+				done += got;
+			}
+			return done;
+		}
+
+		/** Reads exactly bytes at offset. */
+		void readAt(void* data, size_t bytes, uint64_t offset) const
+		{
+			char* p = static_cast<char*>(data);
+			size_t done = 0;
+			while (done < bytes) {
+				ssize_t got = pread(fd_, p + done, bytes - done, offset + done);
+				if (got < 0 && errno == EINTR) {
+					continue;
+				}
+				if (got < 0) {
+					failErrno(path_, "pread");
+				}
+				if (got == 0) {
+					fail(path_, "unexpected end of file");
+				}
+				done += got;
+			}
+		}
+
+		void write(const void* data, size_t bytes)
+		{
+			const char* p = static_cast<const char*>(data);
+			size_t done = 0;
+			while (done < bytes) {
+				ssize_t put = ::write(fd_, p + done, bytes - done);
+				if (put < 0 && errno == EINTR) {
+					continue;
+				}
+				if (put < 0) {
+					failErrno(path_, "write");
+				}
+				done += put;
+			}
+		}
+
+		/** Closes the file, reporting errors the writes may not have. */
+		void close()
+		{
+			int fd = fd_;
+			fd_ = -1;
+			if (::close(fd) != 0) {
+				failErrno(path_, "close");
+			}
+		}
+
+	private:
+		File(int fd, const string& path) : path_(path), fd_(fd) {}
+
+		string path_;
+		int fd_;
+	};
+
+	/** A sorted run: count elements from element first of a run file. */
+	struct Run {
+		uint64_t first;
+		uint64_t count;
+	};
+
+	/**
+	 * Appends elements to a file a block at a time. With overlap, a full
+	 * block is written on a background thread while the next one fills.
+	 */
+	template <typename T>
+	class BlockWriter {
+	public:
+		BlockWriter(File& file, size_t blockElems, bool overlap)
+			: file_(file), block_(blockElems), spare_(overlap ? blockElems : 0),
+			  overlap_(overlap)
+		{
+		}
+
+		BlockWriter(const BlockWriter&) = delete;
+
+		BlockWriter& operator=(const BlockWriter&) = delete;
+
+		~BlockWriter()
+		{
+			if (pending_.valid()) {
+				pending_.wait();
+			}
+		}
+
+		void push(const T& x)
+		{
+			block_[size_++] = x;
+			if (size_ == block_.size()) {
+				flush();
+			}
+		}
+
+		/** Writes out everything pushed so far and waits for it. */
+		void finish()
+		{
+			flush();
+			wait();
+		}
+
+	private:
+		void flush()
+		{
+			if (size_ == 0) {
+				return;
+			}
+			const size_t bytes = size_ * sizeof(T);
+			size_ = 0;
+			if (!overlap_) {
+				file_.write(block_.data(), bytes);
+				return;
+			}
+			wait();
+			swap(block_, spare_);
+			pending_ = async(launch::async, [this, bytes] {
+				file_.write(spare_.data(), bytes);
+			});
+		}
+
+		/** Waits for the write in flight, rethrowing its error. */
+		void wait()
+		{
+			if (pending_.valid()) {
+				pending_.get();
+			}
+		}
+
+		File& file_;
+		vector<T> block_;
+		vector<T> spare_;
+		size_t size_ = 0;
+		bool overlap_;
+		future<void> pending_;
+	};
+
+	/** Reads a run a block at a time. */
+	template <typename T>
+	struct RunReader {
+		const File* file;
+		uint64_t next;		///< Element of the file the next block starts at.
+		uint64_t end;
+		vector<T> block;
+		size_t at = 0;
+		size_t size = 0;
+
+		/** Loads the next block; false at the end of the run. */
+		bool refill()
+		{
+			if (next == end) {
+				return false;
+			}
+			size = static_cast<size_t>(min<uint64_t>(block.size(), end - next));
+			file->readAt(block.data(), size * sizeof(T), next * sizeof(T));
+			next += size;
+			at = 0;
+			return true;
+		}
+	};
+
+	/** Restores a binary min-heap after its top has grown. */
+	template <typename Head>
+	void siftDown(vector<Head>& heap)
+	{
+		const size_t n = heap.size();
+		size_t i = 0;
+		Head moving = heap[0];
+		for (;;) {
+			size_t child = 2 * i + 1;
+			if (child >= n) {
+				break;
+			}
+			if (child + 1 < n && heap[child + 1] < heap[child]) {
+				++child;
+			}
+			if (!(heap[child] < moving)) {
+				break;
+			}
+			heap[i] = heap[child];
+			i = child;
+		}
+		heap[i] = moving;
+	}
+
+	/**
+	 * Merges runs[0, k) of file into out through a heap of the run heads,
+	 * each run read in blocks of blockElems.
+	 */
+	template <typename T>
+	void mergeRuns(const File& file, const Run* runs, size_t k,
+				   size_t blockElems, BlockWriter<T>& out)
+	{
+		vector<RunReader<T>> readers(k);
+		using Head = pair<T, size_t>;	// value, reader
+		vector<Head> heap;
+		heap.reserve(k);
+		for (size_t i = 0; i < k; ++i) {
+			RunReader<T>& r = readers[i];
+			r.file = &file;
+			r.next = runs[i].first;
+			r.end = runs[i].first + runs[i].count;
+			r.block.resize(static_cast<size_t>(
+				min<uint64_t>(blockElems, runs[i].count)));
+			if (r.refill()) {
+				heap.emplace_back(r.block[0], i);
+			}
+		}
+		make_heap(heap.begin(), heap.end(), greater<Head>());
+
+		while (!heap.empty()) {
+			out.push(heap[0].first);
+			RunReader<T>& r = readers[heap[0].second];
+			if (++r.at < r.size || r.refill()) {
+				heap[0].first = r.block[r.at];
+			} else {
+				heap[0] = heap.back();
+				heap.pop_back();
+				if (heap.empty()) {
+					break;
+				}
+			}
+			siftDown(heap);
+		}
+	}
+
+	string directoryOf(const string& path)
+	{
+		size_t slash = path.rfind('/');
+		if (slash == string::npos) {
+			return ".";
+		}
+		return slash == 0 ? "/" : path.substr(0, slash);
+	}
+} // namespace
+
+template <typename T>
+ExternalSortStats algo::externalSort(const string& input, const string& output,
+									 const ExternalSortOptions& options)
+{
+	if (options.memoryBytes < EXTERNAL_SORT_MIN_MEMORY) {
+		throw invalid_argument("externalSort: memoryBytes below "
+							   + to_string(EXTERNAL_SORT_MIN_MEMORY));
+	}
+	const size_t memory = options.memoryBytes;
+	const bool overlap = options.overlapIo;
+	const string dir = options.tempDir.empty() ? directoryOf(output)
+		: options.tempDir;
+
+	File in(input, O_RDONLY);
+	const uint64_t bytes = in.size();
+	if (bytes % sizeof(T) != 0) {
+		fail(input, "size is not a multiple of the element size");
+	}
+	ExternalSortStats stats;
+	stats.elements = bytes / sizeof(T);
+
+	auto readChunk = [&](vector<T>& chunk) {
+		size_t got = in.read(chunk.data(), chunk.size() * sizeof(T));
+		if (got % sizeof(T) != 0) {
+			fail(input, "changed while being sorted");
+		}
+		return got / sizeof(T);
+	};
+
+	// Everything fits: sort it in memory and skip the runs.
+	if (bytes <= memory) {
+		vector<T> all(static_cast<size_t>(stats.elements));
+		if (readChunk(all) != all.size()) {
+			fail(input, "changed while being sorted");
+		}
+		pdqSort(all.begin(), all.end());
+		File out(output, O_WRONLY | O_CREAT | O_TRUNC);
+		out.write(all.data(), all.size() * sizeof(T));
+		out.close();
+		stats.runs = all.empty() ? 0 : 1;
+		return stats;
+	}
+
+	// Cut the input into sorted runs, reading the next chunk while this one
+	// is sorted and written.
+	const size_t chunkElems = (overlap ? memory / 2 : memory) / sizeof(T);
+	vector<T> chunks[2];
+	chunks[0].resize(chunkElems);
+	if (overlap) {
+		chunks[1].resize(chunkElems);
+	}
+	unique_ptr<File> runFile = File::temporary(dir);
+	vector<Run> runs;
+	uint64_t at = 0;
+	int cur = 0;
+	size_t count = readChunk(chunks[0]);
+	while (count > 0) {
+		future<size_t> next;
+		if (overlap) {
+			next = async(launch::async, readChunk, ref(chunks[1 - cur]));
+		}
+		pdqSort(chunks[cur].begin(), chunks[cur].begin() + count);
+		runFile->write(chunks[cur].data(), count * sizeof(T));
+		runs.push_back({at, count});
+		at += count;
+		if (overlap) {
+			count = next.get();
+			cur = 1 - cur;
+		} else {
+			count = readChunk(chunks[0]);
+		}
+	}
+	for (auto& chunk : chunks) {
+		vector<T>().swap(chunk);
+	}
+	stats.runs = runs.size();
+
+	// One read buffer per merged run and one or two write buffers.
+	const size_t writeBlocks = overlap ? 2 : 1;
+	const size_t fanIn = max<size_t>(2, memory / MIN_BLOCK_BYTES - writeBlocks);
+	auto blockElems = [&](size_t k) {
+		return memory / (k + writeBlocks) / sizeof(T);
+	};
+
+	// Merge groups of fanIn runs into longer ones until one pass is enough.
+	while (runs.size() > fanIn) {
+		unique_ptr<File> merged = File::temporary(dir);
+		vector<Run> longer;
+		const size_t block = blockElems(fanIn);
+		BlockWriter<T> out(*merged, block, overlap);
+		uint64_t first = 0;
+		for (size_t i = 0; i < runs.size(); i += fanIn) {
+			const size_t k = min(fanIn, runs.size() - i);
+			mergeRuns(*runFile, &runs[i], k, block, out);
+			uint64_t total = 0;
+			for (size_t j = i; j < i + k; ++j) {
+				total += runs[j].count;
+			}
+			longer.push_back({first, total});
+			first += total;
+		}
+		out.finish();
+		runFile = move(merged);
+		runs = move(longer);
+		++stats.mergePasses;
+	}
+
+	const size_t block = blockElems(runs.size());
+	File out(output, O_WRONLY | O_CREAT | O_TRUNC);
+	{
+		BlockWriter<T> writer(out, block, overlap);
+		mergeRuns(*runFile, runs.data(), runs.size(), block, writer);
+		writer.finish();
+	}
+	out.close();
+	++stats.mergePasses;
+	return stats;
+}
+
+template ExternalSortStats algo::externalSort<int32_t>(
+	const string&, const string&, const ExternalSortOptions&);
+template ExternalSortStats algo::externalSort<uint32_t>(
+	const string&, const string&, const ExternalSortOptions&);
+template ExternalSortStats algo::externalSort<int64_t>(
+	const string&, const string&, const ExternalSortOptions&);
+template ExternalSortStats algo::externalSort<uint64_t>(
+	const string&, const string&, const ExternalSortOptions&);
+
+// EOF
@@ -0,0 +1,1104 @@
+/**
+ * @file graph.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the sparse graph representation and its algorithms.
+ */
+
+#include "graph.hpp"
+#include "dary_heap.hpp"
+#include "radix_heap.hpp"
+#include "thread_pool.hpp"
+#include "union_find.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+
+using namespace std;
+
+namespace {
+	int edgeFrom(const pair<int, int>& e) { return e.first; }
+	int edgeTo(const pair<int, int>& e) { return e.second; }
+	int edgeWeight(const pair<int, int>&) { return 1; }
+
+	int edgeFrom(const Edge& e) { return e.from; }
+	int edgeTo(const Edge& e) { return e.to; }
+	int edgeWeight(const Edge& e) { return e.weight; }
+
+	/**
+	 * Counting sort of an edge list by source vertex: one pass to count the
+	 * degrees, a prefix sum for the offsets, and one pass to scatter. Edges
+	 * with the same source keep their input order.
+	 */
+	template <typename E>
+	CsrGraph buildCsr(int n, const vector<E>& edges, bool directed,
+					  bool weighted)
+	{
+		if (n < 0) {
+			throw invalid_argument("CsrGraph: negative vertex count");
+		}
+
+		vector<uint64_t> offsets(n + 1, 0);
+		for (const auto& e : edges) {
+			int u = edgeFrom(e);
+			int v = edgeTo(e);
+			if (u < 0 || u >= n || v < 0 || v >= n) {
+				throw invalid_argument("CsrGraph: edge endpoint out of range");
+			}
+			++offsets[u + 1];
+			if (!directed) {
+				++offsets[v + 1];
+			}
+		}
+		for (int v = 0; v < n; ++v) {
+			offsets[v + 1] += offsets[v];
+		}
+
+		vector<int> neighbors(offsets[n]);
+		vector<int> weights(weighted ? offsets[n] : 0);
+		// Next free slot of each row.
+		vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+		for (const auto& e : edges) {
+			int u = edgeFrom(e);
+			int v = edgeTo(e);
+			uint64_t i = next[u]++;
+			neighbors[i] = v;
+			if (weighted) {
+				weights[i] = edgeWeight(e);
+			}
+			if (!directed) {
+				i = next[v]++;
+				neighbors[i] = u;
+				if (weighted) {
+					weights[i] = edgeWeight(e);
+				}
+			}
+		}
+		return CsrGraph(move(offsets), move(neighbors), move(weights));
+	}
+
+	// The arrays of a graph that owns its storage.
+	struct CsrArrays {
+		vector<uint64_t> offsets;
+		vector<int> neighbors;
+		vector<int> weights;
+	};
+} // namespace
+
+algo::CsrGraph::CsrGraph(vector<uint64_t> offsets, vector<int> neighbors,
+						 vector<int> weights)
+{
+	if (offsets.empty()) {
+		if (!neighbors.empty() || !weights.empty()) {
+			throw invalid_argument("CsrGraph: edges without offsets");
+		}
+		return;
+	}
+	if (offsets.size() - 1 > static_cast<size_t>(INT_MAX)) {
+		throw invalid_argument("CsrGraph: too many vertices");
+	}
+	if (offsets.back() != neighbors.size()) {
+		throw invalid_argument("CsrGraph: offsets do not span neighbors");
+	}
+	if (!weights.empty() && weights.size() != neighbors.size()) {
+		throw invalid_argument("CsrGraph: weights do not match neighbors");
+	}
+
+	auto arrays = make_shared<CsrArrays>();
+	arrays->offsets = move(offsets);
+	arrays->neighbors = move(neighbors);
+	arrays->weights = move(weights);
+	n_ = static_cast<int>(arrays->offsets.size() - 1);
+	offsets_ = arrays->offsets.data();
+	neighbors_ = arrays->neighbors.data();
+	weights_ = arrays->weights.empty() ? nullptr : arrays->weights.data();
+	owner_ = move(arrays);
+	validate();
+}
+
+CsrGraph algo::CsrGraph::view(int n, const uint64_t* offsets,
+							  const int* neighbors, const int* weights,
+							  shared_ptr<const void> owner)
+{
+	CsrGraph g;
+	g.n_ = n;
+	g.offsets_ = offsets;
+	g.neighbors_ = neighbors;
+	g.weights_ = weights;
+	g.owner_ = move(owner);
+	return g;
+}
+
+void algo::CsrGraph::validate() const
+{
+	if (n_ == 0) {
+		return;
+	}
+	if (offsets_[0] != 0) {
+		throw invalid_argument("CsrGraph: offsets do not start at zero");
+	}
+	for (int v = 0; v < n_; ++v) {
+		if (offsets_[v + 1] < offsets_[v]) {
+			throw invalid_argument("CsrGraph: offsets are not non-decreasing");
+		}
+	}
+	for (int v : neighborArray()) {
+		if (v < 0 || v >= n_) {
+			throw invalid_argument("CsrGraph: neighbor out of range");
+		}
+	}
+}
+
+CsrGraph algo::CsrGraph::fromEdges(int n, const vector<pair<int, int>>& edges,
+								   bool directed)
+{
+	return buildCsr(n, edges, directed, false);
+}
+
+CsrGraph algo::CsrGraph::fromEdges(int n, const vector<Edge>& edges,
+								   bool directed)
+{
+	return buildCsr(n, edges, directed, true);
+}
+
+CsrGraph algo::CsrGraph::fromMatrix(const vector<vector<int>>& adj,
+									bool weighted)
+{
+	const size_t n = adj.size();
+	vector<uint64_t> offsets(n + 1, 0);
+	for (size_t v = 0; v < n; ++v) {
+		offsets[v + 1] = offsets[v] + (n - count(adj[v].begin(),
+			adj[v].begin() + n, 0));
+	}
+
+	vector<int> neighbors;
+	vector<int> weights;
+	neighbors.reserve(offsets[n]);
+	if (weighted) {
+		weights.reserve(offsets[n]);
+	}
+	for (size_t v = 0; v < n; ++v) {
+		for (size_t i = 0; i < n; ++i) {
+			if (adj[v][i]) {
+				neighbors.push_back(static_cast<int>(i));
+				if (weighted) {
+					weights.push_back(adj[v][i]);
+				}
+			}
+		}
+	}
+	return CsrGraph(move(offsets), move(neighbors), move(weights));
+}
+
+CsrGraph algo::CsrGraph::transpose() const
+{
+	const int n = numVertices();
+	vector<uint64_t> offsets(n + 1, 0);
+	for (int u : neighborArray()) {
+		++offsets[u + 1];
+	}
+	for (int v = 0; v < n; ++v) {
+		offsets[v + 1] += offsets[v];
+	}
+
+	vector<int> neighbors(numEdges());
+	vector<int> weights(weighted() ? numEdges() : 0);
+	vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+	for (int v = 0; v < n; ++v) {
+		for (auto e = offsets_[v]; e < offsets_[v + 1]; ++e) {
+			uint64_t i = next[neighbors_[e]]++;
+			neighbors[i] = v;
+			if (weights_) {
+				weights[i] = weights_[e];
+			}
+		}
+	}
+	return CsrGraph(move(offsets), move(neighbors), move(weights));
+}
+
+// Breadth-first search. The output path doubles as the FIFO queue: vertices
+// are appended when discovered and expanded in the order they were appended.
+vector<int> algo::bfs(const CsrGraph& g, int root)
+{
+	vector<bool> visited(g.numVertices(), false);
+	vector<int> path;
+	path.push_back(root);
+	visited[root] = true;
+
+	for (size_t head = 0; head < path.size(); ++head) {
+		for (int u : g.neighbors(path[head])) {
+			if (!visited[u]) {
+				visited[u] = true;
+				path.push_back(u);
+			}
+		}
+	}
+	return path;
+}
+
+namespace {
+	/**
+	 * Fixed-size bitmap, one bit per vertex.
+	 */
+	class Bitmap {
+	public:
+		explicit Bitmap(int n) : words_((n + 63) / 64, 0) {}
+
+		bool test(int i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+
+		void set(int i) { words_[i >> 6] |= uint64_t(1) << (i & 63); }
+
+		void clear() { fill(words_.begin(), words_.end(), 0); }
+
+		void swap(Bitmap& other) { words_.swap(other.words_); }
+
+		size_t numWords() const { return words_.size(); }
+
+		uint64_t word(size_t i) const { return words_[i]; }
+
+	private:
+		vector<uint64_t> words_;
+	};
+
+	/**
+	 * Expands the level path[first, last) by scanning the out-edges of each
+	 * frontier vertex.
+	 *
+	 * @return The out-degree sum of the newly discovered vertices.
+	 */
+	uint64_t topDownStep(const CsrGraph& g, size_t first, size_t last,
+						 Bitmap& visited, Bitmap& next, BfsResult& r)
+	{
+		uint64_t edges = 0;
+		for (size_t i = first; i < last; ++i) {
+			int v = r.path[i];
+			for (int u : g.neighbors(v)) {
+				if (!visited.test(u)) {
+					visited.set(u);
+					next.set(u);
+					r.parent[u] = v;
+					r.dist[u] = r.dist[v] + 1;
+					r.path.push_back(u);
+					edges += g.degree(u);
+				}
+			}
+		}
+		return edges;
+	}
+
+	/**
+	 * Expands the frontier by letting every unvisited vertex look for a parent
+	 * among its in-neighbors. Only the words of the visited bitmap that still
+	 * have a clear bit are scanned, and each vertex stops at its first hit.
+	 *
+	 * @return The out-degree sum of the newly discovered vertices.
+	 */
+	uint64_t bottomUpStep(const CsrGraph& g, const CsrGraph& reverse,
+						  const Bitmap& front, Bitmap& visited, Bitmap& next,
+						  int depth, BfsResult& r)
+	{
+		const int n = g.numVertices();
+		uint64_t edges = 0;
+		for (size_t w = 0; w < visited.numWords(); ++w) {
+			uint64_t todo = ~visited.word(w);
+			while (todo) {
+				int v = static_cast<int>(w * 64 + __builtin_ctzll(todo));
+				todo &= todo - 1;
+				if (v >= n) {
+					break;
+				}
+				for (int u : reverse.neighbors(v)) {
+					if (front.test(u)) {
+						visited.set(v);
+						next.set(v);
+						r.parent[v] = u;
+						r.dist[v] = depth + 1;
+						r.path.push_back(v);
+						edges += g.degree(v);
+						break;
+					}
+				}
+			}
+		}
+		return edges;
+	}
+} // namespace
+
+// Direction-optimizing BFS.
+// https://parlab.eecs.berkeley.edu/sites/all/parlab/files/main.pdf
+BfsResult algo::directionOptimizingBfs(const CsrGraph& g,
+									   const CsrGraph& reverse, int root,
+									   int alpha, int beta)
+{
+	const int n = g.numVertices();
+	BfsResult r;
+	r.dist.assign(n, -1);
+	r.parent.assign(n, -1);
+	r.path.reserve(n);
+
+	Bitmap visited(n);
+	Bitmap front(n);
+	Bitmap next(n);
+	visited.set(root);
+	front.set(root);
+	r.dist[root] = 0;
+	r.parent[root] = root;
+	r.path.push_back(root);
+
+	// Edges to check from the frontier, and edges of unexplored vertices.
+	uint64_t frontierEdges = g.degree(root);
+	uint64_t unexploredEdges = g.numEdges() - frontierEdges;
+	size_t first = 0;
+	bool bottomUp = false;
+	for (int depth = 0; first < r.path.size(); ++depth) {
+		const size_t last = r.path.size();
+		const size_t frontierSize = last - first;
+		if (!bottomUp) {
+			bottomUp = frontierEdges > unexploredEdges / alpha;
+		} else {
+			bottomUp = frontierSize >= static_cast<size_t>(n / beta);
+		}
+
+		next.clear();
+		frontierEdges = bottomUp
+			? bottomUpStep(g, reverse, front, visited, next, depth, r)
+			: topDownStep(g, first, last, visited, next, r);
+		unexploredEdges -= frontierEdges;
+		front.swap(next);
+		first = last;
+	}
+	return r;
+}
+
+BfsResult algo::directionOptimizingBfs(const CsrGraph& g, int root, int alpha,
+									   int beta)
+{
+	return directionOptimizingBfs(g, g, root, alpha, beta);
+}
+
+namespace {
+	/**
+	 * Array of n atomics set to value, filled in parallel so the pages are
+	 * first touched by the threads that will use them.
+	 */
+	template <typename T>
+	unique_ptr<atomic<T>[]> makeAtomicArray(ThreadPool& pool, size_t n,
+											T value)
+	{
+		unique_ptr<atomic<T>[]> a(new atomic<T>[n]);
+		pool.parallelFor(0, n, 1 << 16, [&](int, size_t first, size_t last) {
+			for (size_t i = first; i < last; ++i) {
+				a[i].store(value, memory_order_relaxed);
+			}
+		});
+		return a;
+	}
+
+	/**
+	 * Appends the thread-local buffers to out in thread order, with each
+	 * thread copying its own buffer, and empties them.
+	 */
+	template <typename T>
+	void appendLocal(ThreadPool& pool, vector<vector<T>>& local, vector<T>& out)
+	{
+		vector<size_t> start(local.size() + 1);
+		start[0] = out.size();
+		for (size_t t = 0; t < local.size(); ++t) {
+			start[t + 1] = start[t] + local[t].size();
+		}
+		out.resize(start.back());
+		pool.run([&](int tid) {
+			copy(local[tid].begin(), local[tid].end(),
+				 out.begin() + start[tid]);
+			local[tid].clear();
+		});
+	}
+
+	/**
+	 * Level-synchronous parallel traversal from root along the edges e of v
+	 * for which follow(v, e) holds. Each level's frontier is split into
+	 * chunks that threads claim dynamically; a thread claims a vertex by
+	 * compare-and-swapping its parent from -1, calls visit(u, depth) and
+	 * appends it to a thread-local buffer, and the buffers become the next
+	 * frontier.
+	 *
+	 * @param parent All -1 on entry; the traversal tree on return, with the
+	 * root as its own parent.
+	 *
+	 * @return The reached vertices in level order.
+	 */
+	template <typename Follow, typename Visit>
+	vector<int> parallelLevels(const CsrGraph& g, int root, ThreadPool& pool,
+							   atomic<int>* parent, Follow follow, Visit visit)
+	{
+		// Frontier vertices handed to a thread at a time.
+		const size_t grain = 64;
+
+		vector<int> path;
+		path.reserve(g.numVertices());
+		parent[root].store(root, memory_order_relaxed);
+		visit(root, 0);
+		path.push_back(root);
+
+		vector<vector<int>> local(pool.size());
+		size_t first = 0;
+		for (int depth = 0; first < path.size(); ++depth) {
+			const size_t last = path.size();
+			pool.parallelFor(first, last, grain,
+				[&](int tid, size_t b, size_t e) {
+					vector<int>& out = local[tid];
+					for (size_t i = b; i < e; ++i) {
+						int v = path[i];
+						for (auto j = g.offset(v); j < g.offset(v + 1); ++j) {
+							int u = g.target(j);
+							// Cheap read first, so claimed vertices skip the
+							// CAS.
+							int expected = parent[u].load(memory_order_relaxed);
+							if (expected == -1 && follow(v, j)
+									&& parent[u].compare_exchange_strong(
+										expected, v, memory_order_relaxed)) {
+								visit(u, depth + 1);
+								out.push_back(u);
+							}
+						}
+					}
+				});
+			appendLocal(pool, local, path);
+			first = last;
+		}
+		return path;
+	}
+} // namespace
+
+// Graph500-style level-synchronous BFS.
+BfsResult algo::parallelBfs(const CsrGraph& g, int root, ThreadPool& pool)
+{
+	const int n = g.numVertices();
+	unique_ptr<atomic<int>[]> parent = makeAtomicArray(pool, n, -1);
+
+	BfsResult r;
+	r.dist.assign(n, -1);
+	r.path = parallelLevels(g, root, pool, parent.get(),
+		[](int, uint64_t) { return true; },
+		[&](int u, int depth) { r.dist[u] = depth; });
+
+	r.parent.resize(n);
+	for (int v = 0; v < n; ++v) {
+		r.parent[v] = parent[v].load(memory_order_relaxed);
+	}
+	return r;
+}
+
+vector<int> algo::dfs(const CsrGraph& g, int root)
+{
+	vector<bool> visited(g.numVertices(), false);
+	vector<int> path;
+	vector<int> s;
+	s.push_back(root);
+	visited[root] = true;
+
+	while (!s.empty()) {
+		int v = s.back();
+		s.pop_back();
+		path.push_back(v);
+
+		// Need to reverse iterate or else higher vertices will be at the top of
+		// the stack.
+		const Range<int> row = g.neighbors(v);
+		for (auto it = row.end(); it != row.begin(); ) {
+			int u = *--it;
+			if (!visited[u]) {
+				s.push_back(u);
+				visited[u] = true;
+			}
+		}
+	}
+	return path;
+}
+
+namespace {
+	/**
+	 * Depth-first search from root without recursion. Each stack frame is a
+	 * vertex and the index of its next edge to explore, which is exactly the
+	 * state a recursive call would keep on the call stack, so the stack costs
+	 * 16 bytes per vertex on the current path instead of a call frame.
+	 */
+	void dfsVisit(const CsrGraph& g, int root, int& timer,
+				  vector<pair<int, uint64_t>>& s, DfsResult& r)
+	{
+		r.parent[root] = root;
+		r.discovery[root] = timer++;
+		r.preorder.push_back(root);
+		s.emplace_back(root, g.offset(root));
+
+		while (!s.empty()) {
+			int v = s.back().first;
+			uint64_t& e = s.back().second;
+			if (e == g.offset(v + 1)) {
+				r.finish[v] = timer++;
+				r.postorder.push_back(v);
+				s.pop_back();
+				continue;
+			}
+			int u = g.target(e++);
+			if (r.discovery[u] == -1) {
+				r.parent[u] = v;
+				r.discovery[u] = timer++;
+				r.preorder.push_back(u);
+				s.emplace_back(u, g.offset(u));
+			}
+		}
+	}
+
+	DfsResult makeDfsResult(int n)
+	{
+		DfsResult r;
+		r.preorder.reserve(n);
+		r.postorder.reserve(n);
+		r.discovery.assign(n, -1);
+		r.finish.assign(n, -1);
+		r.parent.assign(n, -1);
+		return r;
+	}
+} // namespace
+
+DfsResult algo::depthFirstSearch(const CsrGraph& g, int root)
+{
+	DfsResult r = makeDfsResult(g.numVertices());
+	vector<pair<int, uint64_t>> s;
+	int timer = 0;
+	dfsVisit(g, root, timer, s, r);
+	return r;
+}
+
+DfsResult algo::depthFirstSearch(const CsrGraph& g)
+{
+	const int n = g.numVertices();
+	DfsResult r = makeDfsResult(n);
+	vector<pair<int, uint64_t>> s;
+	int timer = 0;
+	for (int v = 0; v < n; ++v) {
+		if (r.discovery[v] == -1) {
+			dfsVisit(g, v, timer, s, r);
+		}
+	}
+	return r;
+}
+
+// Depth-first search in post-order, same order as the recursive matrix
+// version, but with an explicit stack so deep graphs cannot overflow.
+vector<int> algo::rdfs(const CsrGraph& g, int root)
+{
+	return depthFirstSearch(g, root).postorder;
+}
+
+/**
+* @pre Directed acylic graph (DAG), meaning the graph must be directed and there
+* must be no cycles.
+*/
+vector<int> algo::topologicalSort(const CsrGraph& g)
+{
+	vector<int> path = depthFirstSearch(g).postorder;
+	reverse(path.begin(), path.end());
+	return path;
+}
+
+namespace {
+	/**
+	 * Finds a directed cycle among the vertices with alive set, by DFS on an
+	 * explicit stack: an edge to a vertex still on the stack closes a cycle,
+	 * which is the stack from that vertex up.
+	 *
+	 * @pre Every alive vertex has an alive predecessor, so a cycle exists.
+	 */
+	vector<int> findCycle(const CsrGraph& g, const vector<bool>& alive)
+	{
+		const int n = g.numVertices();
+		// 0: unvisited, 1: on the stack, 2: done.
+		vector<char> color(n, 0);
+		vector<pair<int, uint64_t>> s;
+		for (int root = 0; root < n; ++root) {
+			if (!alive[root] || color[root]) {
+				continue;
+			}
+			color[root] = 1;
+			s.emplace_back(root, g.offset(root));
+			while (!s.empty()) {
+				int v = s.back().first;
+				uint64_t& e = s.back().second;
+				if (e == g.offset(v + 1)) {
+					color[v] = 2;
+					s.pop_back();
+					continue;
+				}
+				int u = g.target(e++);
+				if (!alive[u] || color[u] == 2) {
+					continue;
+				}
+				if (color[u] == 1) {
+					size_t i = s.size();
+					while (s[i - 1].first != u) {
+						--i;
+					}
+					vector<int> cycle;
+					for (--i; i < s.size(); ++i) {
+						cycle.push_back(s[i].first);
+					}
+					return cycle;
+				}
+				color[u] = 1;
+				s.emplace_back(u, g.offset(u));
+			}
+		}
+		return {};
+	}
+} // namespace
+
+// Kahn's Algorithm.
+// https://en.wikipedia.org/wiki/Topological_sorting#Kahn's_algorithm
+TopologicalOrder algo::kahnTopologicalSort(const CsrGraph& g)
+{
+	const int n = g.numVertices();
+	vector<int> indegree(n, 0);
+	for (int u : g.neighborArray()) {
+		++indegree[u];
+	}
+
+	TopologicalOrder r;
+	r.order.reserve(n);
+	for (int v = 0; v < n; ++v) {
+		if (indegree[v] == 0) {
+			r.order.push_back(v);
+		}
+	}
+
+	// The order doubles as the queue; each pass over [first, last) releases
+	// the next level.
+	vector<int> level(n, -1);
+	size_t first = 0;
+	while (first < r.order.size()) {
+		const size_t last = r.order.size();
+		const int l = static_cast<int>(r.levelOffsets.size());
+		r.levelOffsets.push_back(static_cast<int>(first));
+		for (size_t i = first; i < last; ++i) {
+			level[r.order[i]] = l;
+			for (int u : g.neighbors(r.order[i])) {
+				if (--indegree[u] == 0) {
+					r.order.push_back(u);
+				}
+			}
+		}
+		first = last;
+	}
+	r.levelOffsets.push_back(static_cast<int>(r.order.size()));
+
+	// Levels come out in release order; a counting sort by level over the
+	// ids in increasing order puts each level in id order in linear time.
+	vector<int> next(r.levelOffsets.begin(), r.levelOffsets.end() - 1);
+	for (int v = 0; v < n; ++v) {
+		if (level[v] >= 0) {
+			r.order[next[level[v]]++] = v;
+		}
+	}
+
+	if (r.order.size() < static_cast<size_t>(n)) {
+		// Whatever was never released sits on or behind a cycle.
+		vector<bool> alive(n, true);
+		for (int v : r.order) {
+			alive[v] = false;
+		}
+		r.cycle = findCycle(g, alive);
+	}
+	return r;
+}
+
+// Prim's Algorithm with a binary heap and lazy deletion: O(E log V).
+// https://cp-algorithms.com/graph/mst_prim.html
+int algo::primMst(const CsrGraph& g)
+{
+	const int n = g.numVertices();
+	if (n == 0) {
+		return 0;
+	}
+
+	int cost = 0;
+	int selectedCount = 0;
+	vector<bool> selected(n, false);
+	// { weight, vertex }, smallest weight on top.
+	priority_queue<pair<int, int>, vector<pair<int, int>>,
+		greater<pair<int, int>>> q;
+	// Select an abitrary first vertex (zero index in this case).
+	q.push({ 0, 0 });
+
+	while (!q.empty()) {
+		int w = q.top().first;
+		int v = q.top().second;
+		q.pop();
+		// Stale entry, v was already reached by a lighter edge.
+		if (selected[v]) {
+			continue;
+		}
+
+		selected[v] = true;
+		++selectedCount;
+		cost += w;
+		for (auto e = g.offset(v); e < g.offset(v + 1); ++e) {
+			int to = g.target(e);
+			if (!selected[to]) {
+				q.push({ g.weight(e), to });
+			}
+		}
+	}
+
+	// If not every vertex was reached, the graph is not connected and no MST
+	// exists.
+	return selectedCount == n ? cost : -1;
+}
+
+// Prim's Algorithm with decrease-key, restarted per component.
+// https://cp-algorithms.com/graph/mst_prim.html
+MstResult algo::primMsf(const CsrGraph& g)
+{
+	const int n = g.numVertices();
+	MstResult r;
+	r.cost = 0;
+	r.edges.reserve(n > 0 ? n - 1 : 0);
+
+	IndexedDaryHeap<int> q(n);
+	vector<bool> selected(n, false);
+	vector<int> parent(n, -1);
+	for (int root = 0; root < n; ++root) {
+		if (selected[root]) {
+			continue;
+		}
+		q.push(root, 0);
+		while (!q.empty()) {
+			int w = q.key(q.top());
+			int v = q.pop();
+			selected[v] = true;
+			if (parent[v] != -1) {
+				r.edges.push_back({ parent[v], v, w });
+				r.cost += w;
+			}
+
+			for (auto e = g.offset(v); e < g.offset(v + 1); ++e) {
+				int to = g.target(e);
+				int weight = g.weight(e);
+				if (selected[to]) {
+					continue;
+				}
+				if (!q.contains(to)) {
+					parent[to] = v;
+					q.push(to, weight);
+				} else if (weight < q.key(to)) {
+					parent[to] = v;
+					q.decreaseKey(to, weight);
+				}
+			}
+		}
+	}
+	return r;
+}
+
+namespace {
+	// Converts "infinite" distances to the -1 the results use.
+	void markUnreachable(vector<int64_t>& dist)
+	{
+		for (auto& d : dist) {
+			if (d == numeric_limits<int64_t>::max()) {
+				d = -1;
+			}
+		}
+	}
+} // namespace
+
+// Dijkstra's Algorithm.
+// https://cp-algorithms.com/graph/dijkstra_sparse.html
+ShortestPaths algo::dijkstra(const CsrGraph& g, int root)
+{
+	const int n = g.numVertices();
+	ShortestPaths r;
+	r.dist.assign(n, numeric_limits<int64_t>::max());
+	r.parent.assign(n, -1);
+
+	RadixHeap<int> q;
+	r.dist[root] = 0;
+	r.parent[root] = root;
+	q.push(0, root);
+	while (!q.empty()) {
+		auto top = q.pop();
+		int v = top.second;
+		// Stale entry, v was pushed again with a shorter distance.
+		if (static_cast<int64_t>(top.first) != r.dist[v]) {
+			continue;
+		}
+
+		for (auto e = g.offset(v); e < g.offset(v + 1); ++e) {
+			int w = g.weight(e);
+			if (w < 0) {
+				throw invalid_argument("dijkstra: negative edge weight");
+			}
+			int to = g.target(e);
+			int64_t d = r.dist[v] + w;
+			if (d < r.dist[to]) {
+				r.dist[to] = d;
+				r.parent[to] = v;
+				q.push(d, to);
+			}
+		}
+	}
+	markUnreachable(r.dist);
+	return r;
+}
+
+// Delta-stepping.
+// https://doi.org/10.1016/S0196-6774(03)00076-2
+ShortestPaths algo::deltaStepping(const CsrGraph& g, int root, ThreadPool& pool,
+								  int64_t delta)
+{
+	const int n = g.numVertices();
+	const int64_t INF = numeric_limits<int64_t>::max();
+	// Frontier vertices handed to a thread at a time.
+	const size_t grain = 64;
+
+	int maxWeight = 1;
+	for (int w : g.weightArray()) {
+		if (w < 0) {
+			throw invalid_argument("deltaStepping: negative edge weight");
+		}
+		maxWeight = max(maxWeight, w);
+	}
+	if (delta <= 0) {
+		delta = g.numEdges() ? max<int64_t>(1, static_cast<int64_t>(maxWeight)
+			* n / static_cast<int64_t>(g.numEdges())) : 1;
+	}
+
+	unique_ptr<atomic<int64_t>[]> dist = makeAtomicArray(pool, n, INF);
+	dist[root].store(0, memory_order_relaxed);
+
+	vector<int> frontier(1, root);
+	// bins[tid][i] holds the vertices thread tid put in bucket i.
+	vector<vector<vector<int>>> bins(pool.size());
+	vector<vector<int>> next(pool.size());
+	size_t bin = 0;
+	while (!frontier.empty()) {
+		pool.parallelFor(0, frontier.size(), grain,
+			[&](int tid, size_t b, size_t e) {
+				vector<vector<int>>& mine = bins[tid];
+				for (size_t i = b; i < e; ++i) {
+					int v = frontier[i];
+					int64_t dv = dist[v].load(memory_order_relaxed);
+					// Stale entry, v was settled in an earlier bucket.
+					if (static_cast<size_t>(dv / delta) < bin) {
+						continue;
+					}
+					for (auto j = g.offset(v); j < g.offset(v + 1); ++j) {
+						int to = g.target(j);
+						int64_t d = dv + g.weight(j);
+						int64_t cur = dist[to].load(memory_order_relaxed);
+						while (d < cur) {
+							if (dist[to].compare_exchange_weak(cur, d,
+									memory_order_relaxed)) {
+								size_t k = static_cast<size_t>(d / delta);
+								if (k >= mine.size()) {
+									mine.resize(k + 1);
+								}
+								mine[k].push_back(to);
+								break;
+							}
+						}
+					}
+				}
+			});
+
+		// The next bucket is the lowest non-empty one over all threads; it
+		// is the current one again if it refilled.
+		size_t lowest = SIZE_MAX;
+		for (const auto& mine : bins) {
+			for (size_t i = bin; i < mine.size() && i < lowest; ++i) {
+				if (!mine[i].empty()) {
+					lowest = i;
+					break;
+				}
+			}
+		}
+		frontier.clear();
+		if (lowest == SIZE_MAX) {
+			break;
+		}
+		bin = lowest;
+		for (int t = 0; t < pool.size(); ++t) {
+			if (bin < bins[t].size()) {
+				next[t].swap(bins[t][bin]);
+			}
+		}
+		appendLocal(pool, next, frontier);
+	}
+
+	ShortestPaths r;
+	r.dist.resize(n);
+	for (int v = 0; v < n; ++v) {
+		r.dist[v] = dist[v].load(memory_order_relaxed);
+	}
+	unique_ptr<atomic<int>[]> parent = makeAtomicArray(pool, n, -1);
+	parallelLevels(g, root, pool, parent.get(),
+		[&](int v, uint64_t e) {
+			return r.dist[v] + g.weight(e) == r.dist[g.target(e)];
+		},
+		[](int, int) {});
+	r.parent.resize(n);
+	for (int v = 0; v < n; ++v) {
+		r.parent[v] = parent[v].load(memory_order_relaxed);
+	}
+	markUnreachable(r.dist);
+	return r;
+}
+
+// Kruskal's Algorithm.
+// https://cp-algorithms.com/graph/mst_kruskal.html
+MstResult algo::kruskalMst(int n, const vector<Edge>& edges)
+{
+	vector<Edge> sorted(edges);
+	sort(sorted.begin(), sorted.end(), [](const Edge& a, const Edge& b) {
+		return a.weight < b.weight;
+	});
+
+	MstResult r;
+	r.cost = 0;
+	UnionFind trees(n);
+	for (const auto& e : sorted) {
+		if (trees.unite(e.from, e.to)) {
+			r.cost += e.weight;
+			r.edges.push_back(e);
+			if (r.edges.size() + 1 == static_cast<size_t>(n)) {
+				break;	// spanning tree complete
+			}
+		}
+	}
+	return r;
+}
+
+// Boruvka's Algorithm.
+// https://en.wikipedia.org/wiki/Bor%C5%AFvka%27s_algorithm
+MstResult algo::boruvkaMst(int n, const vector<Edge>& edges, ThreadPool& pool)
+{
+	if (edges.size() > UINT32_MAX) {
+		throw invalid_argument("boruvkaMst: more than 2^32 edges");
+	}
+	const uint64_t NONE = UINT64_MAX;
+	const size_t grain = 1 << 12;
+
+	// Lightest edge of each component, packed as { weight, edge index } so
+	// one 64-bit atomic minimum compares both. Flipping the sign bit makes
+	// signed weights order correctly as unsigned.
+	auto pack = [&](uint32_t e) {
+		uint32_t w = static_cast<uint32_t>(edges[e].weight) ^ 0x80000000u;
+		return (static_cast<uint64_t>(w) << 32) | e;
+	};
+	unique_ptr<atomic<uint64_t>[]> best = makeAtomicArray(pool, n, NONE);
+	auto offer = [&](int c, uint64_t key) {
+		uint64_t cur = best[c].load(memory_order_relaxed);
+		while (key < cur && !best[c].compare_exchange_weak(cur, key,
+				memory_order_relaxed)) {
+		}
+	};
+
+	vector<int> comp(n);
+	for (int v = 0; v < n; ++v) {
+		comp[v] = v;
+	}
+	vector<uint32_t> active(edges.size());
+	for (size_t e = 0; e < edges.size(); ++e) {
+		active[e] = static_cast<uint32_t>(e);
+	}
+	vector<int> roots(comp);
+	vector<int> rep(n);
+
+	MstResult r;
+	r.cost = 0;
+	UnionFind trees(n);
+	vector<vector<uint32_t>> local(pool.size());
+	while (!active.empty()) {
+		for (int c : roots) {
+			best[c].store(NONE, memory_order_relaxed);
+		}
+		pool.parallelFor(0, active.size(), grain, [&](int, size_t b, size_t e) {
+			for (size_t i = b; i < e; ++i) {
+				const Edge& edge = edges[active[i]];
+				int cu = comp[edge.from];
+				int cv = comp[edge.to];
+				if (cu != cv) {	// self-loops never leave a component
+					uint64_t key = pack(active[i]);
+					offer(cu, key);
+					offer(cv, key);
+				}
+			}
+		});
+
+		// Hook components along their lightest edges. An edge that is the
+		// lightest for both of its components is only taken once.
+		bool merged = false;
+		for (int c : roots) {
+			uint64_t key = best[c].load(memory_order_relaxed);
+			if (key == NONE) {
+				continue;
+			}
+			const Edge& edge = edges[static_cast<uint32_t>(key)];
+			if (trees.unite(comp[edge.from], comp[edge.to])) {
+				r.edges.push_back(edge);
+				r.cost += edge.weight;
+				merged = true;
+			}
+		}
+		if (!merged) {
+			break;
+		}
+
+		// Relabel: old roots look up their new root sequentially, so the
+		// union-find is not compressed concurrently and the parallel pass
+		// over the vertices only reads.
+		vector<int> next;
+		for (int c : roots) {
+			rep[c] = trees.find(c);
+			if (rep[c] == c) {
+				next.push_back(c);
+			}
+		}
+		roots.swap(next);
+		pool.parallelFor(0, n, grain, [&](int, size_t b, size_t e) {
+			for (size_t v = b; v < e; ++v) {
+				comp[v] = rep[comp[v]];
+			}
+		});
+
+		// Drop the edges that are now inside one component.
+		pool.parallelFor(0, active.size(), grain,
+			[&](int tid, size_t b, size_t e) {
+				for (size_t i = b; i < e; ++i) {
+					const Edge& edge = edges[active[i]];
+					if (comp[edge.from] != comp[edge.to]) {
+						local[tid].push_back(active[i]);
+					}
+				}
+			});
+		active.clear();
+		appendLocal(pool, local, active);
+	}
+	return r;
+}
+
+// EOF
@@ -0,0 +1,381 @@
+/**
+ * @file graph_io.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the binary CSR format and the edge list converter.
+ */
+
+#include "graph_io.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace algo;
+
+using namespace std;
+
+constexpr uint32_t algo::CsrFileHeader::VERSION;
+constexpr uint32_t algo::CsrFileHeader::ENDIAN_MARK;
+constexpr uint32_t algo::CsrFileHeader::WEIGHTED;
+
+namespace {
+	const char MAGIC[8] = "ALGOCSR";
+
+	[[noreturn]] void fail(const string& path, const string& what)
+	{
+		throw runtime_error(path + ": " + what);
+	}
+
+	[[noreturn]] void failErrno(const string& path, const char* call)
+	{
+		fail(path, string(call) + ": " + strerror(errno));
+	}
+
+	uint64_t alignUp(uint64_t pos) { return (pos + 63) & ~uint64_t(63); }
+
+	/**
+	 * Header of a file with the given shape; the arrays follow each other
+	 * on 64-byte boundaries.
+	 */
+	CsrFileHeader makeHeader(uint64_t n, uint64_t m, bool weighted)
+	{
+		CsrFileHeader h;
+		memset(&h, 0, sizeof h);
+		memcpy(h.magic, MAGIC, sizeof h.magic);
+		h.version = CsrFileHeader::VERSION;
+		h.flags = weighted ? CsrFileHeader::WEIGHTED : 0;
+		h.numVertices = n;
+		h.numEdges = m;
+		h.offsetsAt = sizeof h;
+		h.neighborsAt = alignUp(h.offsetsAt + (n + 1) * sizeof(uint64_t));
+		h.weightsAt = weighted
+			? alignUp(h.neighborsAt + m * sizeof(int32_t)) : 0;
+		h.byteOrder = CsrFileHeader::ENDIAN_MARK;
+		return h;
+	}
+
+	/** Size of the file described by h. */
+	uint64_t fileSize(const CsrFileHeader& h)
+	{
+		return (h.weightsAt ? h.weightsAt : h.neighborsAt)
+			+ h.numEdges * sizeof(int32_t);
+	}
+
+	/** A whole file mapped into memory, unmapped on destruction. */
+	class Mapping {
+	public:
+		Mapping(const string& path, bool writable, uint64_t size = 0)
+		{
+			int fd = writable ? open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+									 0644)
+				: open(path.c_str(), O_RDONLY);
+			if (fd < 0) {
+				failErrno(path, "open");
+			}
+			if (writable) {
+				if (ftruncate(fd, size) != 0) {
+					int err = errno;
+					close(fd);
+					errno = err;
+					failErrno(path, "ftruncate");
+				}
+			} else {
+				struct stat st;
+				if (fstat(fd, &st) != 0) {
+					int err = errno;
+					close(fd);
+					errno = err;
+					failErrno(path, "fstat");
+				}
+				size = st.st_size;
+			}
+
+			size_ = size;
+			if (size_ > 0) {
+				void* p = mmap(nullptr, size_,
+							   writable ? PROT_READ | PROT_WRITE : PROT_READ,
+							   writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+				if (p == MAP_FAILED) {
+					int err = errno;
+					close(fd);
+					errno = err;
+					failErrno(path, "mmap");
+				}
+				data_ = static_cast<char*>(p);
+			}
+			close(fd);
+		}
+
+		Mapping(const Mapping&) = delete;
+		Mapping& operator=(const Mapping&) = delete;
+
+		~Mapping()
+		{
+			if (data_) {
+				munmap(data_, size_);
+			}
+		}
+
+		char* data() const { return data_; }
+
+		uint64_t size() const { return size_; }
+
+	private:
+		char* data_ = nullptr;
+		uint64_t size_ = 0;
+	};
+
+	/**
+	 * Calls fn(from, to, weight, hasWeight) for every edge line of a text
+	 * edge list, parsing straight out of a mapping of the file.
+	 */
+	template <typename Fn>
+	void forEachEdge(const string& path, Fn fn)
+	{
+		Mapping text(path, false);
+		const char* p = text.data();
+		const char* end = p + text.size();
+		uint64_t line = 0;
+
+		auto error = [&](const char* what) {
+			fail(path, to_string(line) + ": " + what);
+		};
+		auto isBlank = [](char c) {
+			return c == ' ' || c == '\t' || c == '\r';
+		};
+
+		while (p < end) {
+			++line;
+			long long fields[3];
+			int count = 0;
+			while (true) {
+				while (p < end && isBlank(*p)) {
+					++p;
+				}
+				if (p == end || *p == '\n') {
+					break;
+				}
+				if (count == 0 && (*p == '#' || *p == '%')) {
+					while (p < end && *p != '\n') {
+						++p;
+					}
+					break;
+				}
+				if (count == 3) {
+					error("too many fields");
+				}
+				bool negative = p < end && *p == '-';
+				if (negative || *p == '+') {
+					++p;
+				}
+				if (p == end || *p < '0' || *p > '9') {
+					error("expected a number");
+				}
+				long long value = 0;
+				while (p < end && *p >= '0' && *p <= '9') {
+					value = value * 10 + (*p++ - '0');
+					if (value > INT_MAX + 1LL) {
+						error("number out of range");
+					}
+				}
+				if (p < end && !isBlank(*p) && *p != '\n') {
+					error("expected a number");
+				}
+				fields[count++] = negative ? -value : value;
+			}
+			if (p < end) {
+				++p;	// newline
+			}
+
+			if (count == 0) {
+				continue;
+			}
+			if (count == 1) {
+				error("expected from, to and an optional weight");
+			}
+			if (fields[0] < 0 || fields[0] >= INT_MAX
+					|| fields[1] < 0 || fields[1] >= INT_MAX) {
+				error("vertex id out of range");
+			}
+			if (count == 3 && fields[2] > INT_MAX) {
+				error("weight out of range");
+			}
+			fn(static_cast<int>(fields[0]), static_cast<int>(fields[1]),
+			   count == 3 ? static_cast<int>(fields[2]) : 1, count == 3);
+		}
+	}
+} // namespace
+
+void algo::saveCsr(const CsrGraph& g, const string& path)
+{
+	const uint64_t n = g.numVertices();
+	const uint64_t m = g.numEdges();
+	const CsrFileHeader h = makeHeader(n, m, g.weighted());
+
+	unique_ptr<FILE, int (*)(FILE*)> file(fopen(path.c_str(), "wb"), fclose);
+	if (!file) {
+		failErrno(path, "fopen");
+	}
+	const char zeros[64] = {};
+	uint64_t pos = 0;
+	auto write = [&](uint64_t at, const void* data, uint64_t bytes) {
+		if (fwrite(zeros, 1, at - pos, file.get()) != at - pos
+				|| fwrite(data, 1, bytes, file.get()) != bytes) {
+			failErrno(path, "fwrite");
+		}
+		pos = at + bytes;
+	};
+
+	write(0, &h, sizeof h);
+	if (n == 0) {
+		const uint64_t zero = 0;
+		write(h.offsetsAt, &zero, sizeof zero);
+	} else {
+		write(h.offsetsAt, g.offsets().begin(), (n + 1) * sizeof(uint64_t));
+	}
+	write(h.neighborsAt, g.neighborArray().begin(), m * sizeof(int32_t));
+	if (g.weighted()) {
+		write(h.weightsAt, g.weightArray().begin(), m * sizeof(int32_t));
+	}
+	if (fclose(file.release()) != 0) {
+		failErrno(path, "fclose");
+	}
+}
+
+CsrGraph algo::loadCsr(const string& path, bool verify)
+{
+	auto file = make_shared<Mapping>(path, false);
+	if (file->size() < sizeof(CsrFileHeader)) {
+		fail(path, "not a CSR file");
+	}
+	CsrFileHeader h;
+	memcpy(&h, file->data(), sizeof h);
+	if (memcmp(h.magic, MAGIC, sizeof h.magic) != 0) {
+		fail(path, "not a CSR file");
+	}
+	if (h.byteOrder != CsrFileHeader::ENDIAN_MARK) {
+		fail(path, "written with a different byte order");
+	}
+	if (h.version != CsrFileHeader::VERSION) {
+		fail(path, "unsupported version " + to_string(h.version));
+	}
+	// Comparing against the layout this build would write checks the
+	// alignment and bounds of every array at once.
+	const bool weighted = h.flags & CsrFileHeader::WEIGHTED;
+	if (h.numVertices >= static_cast<uint64_t>(INT_MAX)
+			|| h.numEdges > file->size()) {
+		fail(path, "corrupt header");
+	}
+	const CsrFileHeader expected = makeHeader(h.numVertices, h.numEdges,
+											  weighted);
+	if (h.offsetsAt != expected.offsetsAt
+			|| h.neighborsAt != expected.neighborsAt
+			|| h.weightsAt != expected.weightsAt
+			|| fileSize(h) > file->size()) {
+		fail(path, "corrupt header");
+	}
+
+	const char* base = file->data();
+	const auto* offsets = reinterpret_cast<const uint64_t*>(base + h.offsetsAt);
+	if (offsets[0] != 0 || offsets[h.numVertices] != h.numEdges) {
+		fail(path, "offsets do not span the neighbors");
+	}
+
+	const int n = static_cast<int>(h.numVertices);
+	CsrGraph g = n == 0 ? CsrGraph()
+		: CsrGraph::view(n, offsets,
+						 reinterpret_cast<const int*>(base + h.neighborsAt),
+						 weighted
+							 ? reinterpret_cast<const int*>(base + h.weightsAt)
+							 : nullptr,
+						 move(file));
+	if (verify) {
+		g.validate();
+	}
+	return g;
+}
+
+void algo::convertEdgeList(const string& textPath, const string& csrPath,
+						   bool directed)
+{
+	// Pass 1: degrees, vertex count and whether the edges are weighted.
+	vector<uint64_t> degree;
+	uint64_t m = 0;
+	int weighted = -1;
+	forEachEdge(textPath, [&](int u, int v, int, bool hasWeight) {
+		if (weighted < 0) {
+			weighted = hasWeight;
+		} else if (weighted != hasWeight) {
+			fail(textPath, "edges must all have weights or none");
+		}
+		int hi = max(u, v);
+		if (static_cast<size_t>(hi) >= degree.size()) {
+			degree.resize(hi + 1, 0);
+		}
+		++degree[u];
+		++m;
+		if (!directed) {
+			++degree[v];
+			++m;
+		}
+	});
+
+	const uint64_t n = degree.size();
+	const CsrFileHeader h = makeHeader(n, m, weighted > 0);
+	Mapping out(csrPath, true, fileSize(h));
+	char* base = out.data();
+	memcpy(base, &h, sizeof h);
+
+	// Offsets, and the next free slot of each row reusing the degrees.
+	auto* offsets = reinterpret_cast<uint64_t*>(base + h.offsetsAt);
+	offsets[0] = 0;
+	for (uint64_t v = 0; v < n; ++v) {
+		offsets[v + 1] = offsets[v] + degree[v];
+		degree[v] = offsets[v];
+	}
+
+	// Pass 2: scatter the edges into place.
+	auto* neighbors = reinterpret_cast<int*>(base + h.neighborsAt);
+	auto* weights = h.weightsAt ? reinterpret_cast<int*>(base + h.weightsAt)
+		: nullptr;
+	forEachEdge(textPath, [&](int u, int v, int w, bool) {
+		if (static_cast<uint64_t>(max(u, v)) >= n) {
+			fail(textPath, "changed while being converted");
+		}
+		uint64_t i = degree[u]++;
+		neighbors[i] = v;
+		if (weights) {
+			weights[i] = w;
+		}
+		if (!directed) {
+			i = degree[v]++;
+			neighbors[i] = u;
+			if (weights) {
+				weights[i] = w;
+			}
+		}
+	});
+
+	if (msync(base, out.size(), MS_SYNC) != 0) {
+		failErrno(csrPath, "msync");
+	}
+}
+
+// EOF
@@ -1,10 +1,26 @@
 #include "algo.hpp"
+#include "dary_heap.hpp"
+#include "radix_heap.hpp"
+#include "task_pool.hpp"
+#include "thread_pool.hpp"
+#include "union_find.hpp"
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 // Set to FALSE to use default gtest.
 const bool NANOSECONDS = true;
@@ -73,6 +89,13 @@ private:
     std::chrono::high_resolution_clock::time_point start_time_;
 };
 
+// Copies a graph array so it can be compared against an expected vector.
+template <typename T>
+std::vector<T> asVector(algo::Range<T> r)
+{
+    return std::vector<T>(r.begin(), r.end());
+}
+
 // Define test cases
 TEST(AlgoTests, IsPalindrome)
 {
@@ -124,16 +147,16 @@ TEST(AlgoTests, PrimMST)
     EXPECT_EQ(algo::primMst(adj), 4);  // Example known result
 }
 
-//TEST(AlgoTests, KruskalMST)
-//{
-//    std::vector<std::vector<int>> adj = {
-//        {0, 10, 6, 5},
-//        {10, 0, 0, 15},
-//        {6, 0, 0, 4},
-//        {5, 15, 4, 0}
-//    };
-//    EXPECT_EQ(algo::kruskalMst(adj, 4), 19);  // Example known result
-//}
+TEST(AlgoTests, KruskalMST)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 10, 6, 5},
+        {10, 0, 0, 15},
+        {6, 0, 0, 4},
+        {5, 15, 4, 0}
+    };
+    EXPECT_EQ(algo::kruskalMst(adj, 4), 19);  // Example known result
+}
 
 TEST(AlgoTests, BFS) 
 {
@@ -184,16 +207,45 @@ TEST(AlgoTests, RDFS)
     EXPECT_EQ(actual_path, expected_path);
 }
 
-//TEST(AlgoTests, ShortestPath)
-//{
-//    std::vector<std::vector<int>> adj = {
-//        {0, 1, 4, 0},
-//        {0, 0, 2, 0},
-//        {0, 0, 0, 3},
-//        {0, 0, 0, 0}
-//    };
-//    EXPECT_EQ(algo::shortestPath(adj, 0), 7); // Modify based on implementation
-//}
+TEST(AlgoTests, RDFSTimed)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 1, 0, 0},  // Node 0 connects to 1 and 2
+        {0, 0, 0, 1, 0},  // Node 1 connects to 3
+        {0, 0, 0, 0, 1},  // Node 2 connects to 4
+        {0, 0, 0, 0, 0},  // Node 3 has no outgoing edges
+        {0, 0, 0, 0, 0}   // Node 4 has no outgoing edges
+    };
+
+    algo::DfsResult r = algo::rdfsTimed(adj, 0);
+    EXPECT_EQ(r.preorder, std::vector<int>({0, 1, 3, 2, 4}));
+    EXPECT_EQ(r.postorder, algo::rdfs(adj, 0));
+    EXPECT_EQ(r.discovery, std::vector<int>({0, 1, 5, 2, 6}));
+    EXPECT_EQ(r.finish, std::vector<int>({9, 4, 8, 3, 7}));
+    EXPECT_EQ(r.parent, std::vector<int>({0, 0, 0, 1, 2}));
+
+    std::vector<int> color(adj.size(), -1);
+    std::vector<int> inTime(adj.size(), -1);
+    std::vector<int> outTime(adj.size(), -1);
+    int timer = 0;
+    algo::rdfsTimedHelper(adj, 0, color, timer, inTime, outTime);
+    EXPECT_EQ(inTime, r.discovery);
+    EXPECT_EQ(outTime, r.finish);
+    EXPECT_EQ(color, std::vector<int>(adj.size(), 2));
+}
+
+TEST(AlgoTests, ShortestPath)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 4, 0},
+        {0, 0, 2, 0},
+        {0, 0, 0, 3},
+        {0, 0, 0, 0}
+    };
+    algo::ShortestPaths r = algo::shortestPath(adj, 0);
+    EXPECT_EQ(r.dist, std::vector<std::int64_t>({0, 1, 3, 6}));	// 0-1-2-3
+    EXPECT_EQ(r.parent, std::vector<int>({0, 0, 1, 2}));
+}
 
 TEST(AlgoTests, RotateMatrixClockwise)
 {
@@ -342,6 +394,1361 @@ TEST(MatrixTests, ReverseMatrixColumn) {
     EXPECT_EQ(mat[2][1], 2);
 }
 
+TEST(GraphTests, CsrFromMatrix)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 2, 0},
+        {1, 0, 0, 3},
+        {2, 0, 0, 1},
+        {0, 3, 1, 0}
+    };
+    algo::CsrGraph g = algo::CsrGraph::fromMatrix(adj, true);
+    EXPECT_EQ(g.numVertices(), 4);
+    EXPECT_EQ(g.numEdges(), 8u);
+    EXPECT_EQ(asVector(g.offsets()), std::vector<std::uint64_t>({0, 2, 4, 6, 8}));
+    EXPECT_EQ(asVector(g.neighborArray()), std::vector<int>({1, 2, 0, 3, 0, 3, 1, 2}));
+    EXPECT_EQ(asVector(g.weightArray()), std::vector<int>({1, 2, 1, 3, 2, 1, 3, 1}));
+
+    algo::CsrGraph u = algo::CsrGraph::fromMatrix(adj);
+    EXPECT_FALSE(u.weighted());
+    EXPECT_EQ(u.weight(3), 1);
+}
+
+TEST(GraphTests, CsrFromEdges)
+{
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(4,
+        std::vector<std::pair<int, int>>({{0, 1}, {2, 3}, {0, 2}}));
+    EXPECT_EQ(asVector(g.offsets()), std::vector<std::uint64_t>({0, 2, 2, 3, 3}));
+    EXPECT_EQ(asVector(g.neighborArray()), std::vector<int>({1, 2, 3}));
+
+    algo::CsrGraph u = algo::CsrGraph::fromEdges(3,
+        std::vector<algo::Edge>({{0, 1, 5}, {1, 2, 7}}), false);
+    EXPECT_EQ(u.numEdges(), 4u);
+    EXPECT_EQ(u.degree(1), 2u);
+    EXPECT_EQ(asVector(u.neighborArray()), std::vector<int>({1, 0, 2, 1}));
+    EXPECT_EQ(asVector(u.weightArray()), std::vector<int>({5, 5, 7, 7}));
+
+    EXPECT_THROW(algo::CsrGraph::fromEdges(2,
+        std::vector<std::pair<int, int>>({{0, 2}})), std::invalid_argument);
+    EXPECT_THROW(algo::CsrGraph({0, 2}, {1}), std::invalid_argument);
+}
+
+TEST(GraphTests, CsrTraversalsMatchMatrix)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 1, 0, 0},  // Node 0 connects to 1 and 2
+        {0, 0, 0, 1, 0},  // Node 1 connects to 3
+        {0, 0, 0, 0, 1},  // Node 2 connects to 4
+        {0, 0, 0, 0, 0},  // Node 3 has no outgoing edges
+        {0, 0, 0, 0, 0}   // Node 4 has no outgoing edges
+    };
+    algo::CsrGraph g = algo::CsrGraph::fromMatrix(adj);
+
+    EXPECT_EQ(algo::bfs(g, 0), algo::bfs(adj, 0));
+    EXPECT_EQ(algo::dfs(g, 0), algo::dfs(adj, 0));
+    EXPECT_EQ(algo::rdfs(g, 0), algo::rdfs(adj, 0));
+    EXPECT_EQ(algo::topologicalSort(g), algo::topologicalSort(adj));
+}
+
+TEST(GraphTests, DirectionOptimizingBFS)
+{
+    // Random undirected graph with a few isolated vertices at the end.
+    const int n = 2000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, n - 11);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 8 * n; ++i) {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(n, edges, false);
+    std::vector<int> expected = algo::bfs(g, 0);
+
+    // Default heuristic, mostly top-down, and bottom-up from the first level.
+    for (int alpha : {14, 1, 1 << 30}) {
+        algo::BfsResult r = algo::directionOptimizingBfs(g, 0, alpha);
+        ASSERT_EQ(r.path.size(), expected.size());
+        EXPECT_TRUE(std::is_permutation(r.path.begin(), r.path.end(),
+            expected.begin()));
+        EXPECT_EQ(r.parent[0], 0);
+        EXPECT_EQ(r.dist[0], 0);
+        EXPECT_EQ(r.dist[n - 1], -1);
+        for (size_t i = 1; i < r.path.size(); ++i) {
+            int v = r.path[i];
+            EXPECT_LE(r.dist[r.path[i - 1]], r.dist[v]);
+            EXPECT_EQ(r.dist[v], r.dist[r.parent[v]] + 1);
+        }
+    }
+}
+
+TEST(GraphTests, DirectionOptimizingBFSDirected)
+{
+    // 0 -> 1 -> 2, 3 -> 0; 3 is not reachable from 0.
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(4,
+        std::vector<std::pair<int, int>>({{0, 1}, {1, 2}, {3, 0}}));
+    algo::BfsResult r = algo::directionOptimizingBfs(g, g.transpose(), 0,
+        1 << 30);
+    EXPECT_EQ(r.path, std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(r.dist, std::vector<int>({0, 1, 2, -1}));
+    EXPECT_EQ(r.parent, std::vector<int>({0, 0, 1, -1}));
+}
+
+TEST(GraphTests, ParallelBFS)
+{
+    const int n = 5000;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 4 * n; ++i) {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(n, edges, false);
+    algo::BfsResult expected = algo::directionOptimizingBfs(g, 0);
+
+    for (int threads : {1, 4}) {
+        algo::ThreadPool pool(threads);
+        algo::BfsResult r = algo::parallelBfs(g, 0, pool);
+        EXPECT_EQ(r.dist, expected.dist);
+        ASSERT_EQ(r.path.size(), expected.path.size());
+        EXPECT_EQ(r.parent[0], 0);
+        for (size_t i = 1; i < r.path.size(); ++i) {
+            int v = r.path[i];
+            EXPECT_EQ(r.dist[r.parent[v]] + 1, r.dist[v]);
+            EXPECT_LE(r.dist[r.path[i - 1]], r.dist[v]);
+        }
+    }
+}
+
+TEST(ThreadPoolTests, ParallelFor)
+{
+    algo::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::vector<int> hits(10000, 0);
+    pool.parallelFor(0, hits.size(), 7, [&](int, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            ++hits[i];
+        }
+    });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 10000);
+
+    std::vector<int> ran(pool.size(), 0);
+    pool.run([&](int tid) { ran[tid] = 1; });
+    EXPECT_EQ(ran, std::vector<int>(4, 1));
+
+    EXPECT_THROW(pool.run([](int tid) {
+        if (tid == 2) {
+            throw std::runtime_error("worker failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(GraphTests, DepthFirstSearchForest)
+{
+    // Two trees: 0 -> {1, 2}, 2 -> 1, and 3 -> 4, plus a back edge 4 -> 3.
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(5,
+        std::vector<std::pair<int, int>>({{0, 1}, {0, 2}, {2, 1}, {3, 4},
+            {4, 3}}));
+    algo::DfsResult r = algo::depthFirstSearch(g);
+    EXPECT_EQ(r.preorder, std::vector<int>({0, 1, 2, 3, 4}));
+    EXPECT_EQ(r.postorder, std::vector<int>({1, 2, 0, 4, 3}));
+    EXPECT_EQ(r.parent, std::vector<int>({0, 0, 0, 3, 3}));
+    for (int v = 0; v < g.numVertices(); ++v) {
+        int p = r.parent[v];
+        EXPECT_LT(r.discovery[v], r.finish[v]);
+        EXPECT_LE(r.discovery[p], r.discovery[v]);
+        EXPECT_GE(r.finish[p], r.finish[v]);
+    }
+    EXPECT_EQ(algo::depthFirstSearch(g, 3).discovery,
+        std::vector<int>({-1, -1, -1, 0, 1}));
+}
+
+TEST(GraphTests, CsrRdfsDeepPath)
+{
+    // A path this long overflows the call stack with a recursive DFS.
+    const int n = 1000000;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; ++i) {
+        edges.push_back({i, i + 1});
+    }
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(n, edges);
+
+    std::vector<int> path = algo::rdfs(g, 0);
+    ASSERT_EQ(path.size(), static_cast<size_t>(n));
+    EXPECT_EQ(path.front(), n - 1);
+    EXPECT_EQ(path.back(), 0);
+
+    algo::DfsResult r = algo::depthFirstSearch(g, 0);
+    EXPECT_EQ(r.discovery[n - 1], n - 1);
+    EXPECT_EQ(r.finish[0], 2 * n - 1);
+
+    std::vector<int> order = algo::topologicalSort(g);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST(GraphTests, CsrPrimMST)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 2, 0},
+        {1, 0, 0, 3},
+        {2, 0, 0, 1},
+        {0, 3, 1, 0}
+    };
+    EXPECT_EQ(algo::primMst(algo::CsrGraph::fromMatrix(adj, true)), 4);
+
+    // Two components: no spanning tree.
+    algo::CsrGraph split = algo::CsrGraph::fromEdges(4,
+        std::vector<algo::Edge>({{0, 1, 1}, {2, 3, 1}}), false);
+    EXPECT_EQ(algo::primMst(split), -1);
+}
+
+TEST(GraphTests, PrimMSF)
+{
+    std::vector<std::vector<int>> adj = {
+        {0, 1, 2, 0},
+        {1, 0, 0, 3},
+        {2, 0, 0, 1},
+        {0, 3, 1, 0}
+    };
+    algo::MstResult r = algo::primMsf(algo::CsrGraph::fromMatrix(adj, true));
+    EXPECT_EQ(r.cost, algo::primMst(adj));
+    ASSERT_EQ(r.edges.size(), 3u);
+    EXPECT_EQ(r.edges[0].from, 0);
+    EXPECT_EQ(r.edges[0].to, 1);
+    EXPECT_EQ(r.edges[0].weight, 1);
+
+    // Two components with weights whose sum overflows an int.
+    const int big = 2000000000;
+    algo::CsrGraph forest = algo::CsrGraph::fromEdges(5,
+        std::vector<algo::Edge>({{0, 1, big}, {1, 2, big}, {0, 2, 5},
+            {3, 4, big}}), false);
+    r = algo::primMsf(forest);
+    EXPECT_EQ(r.edges.size(), 3u);
+    EXPECT_EQ(r.cost, 5 + 2 * static_cast<std::int64_t>(big));
+}
+
+TEST(HeapTests, IndexedDaryHeap)
+{
+    algo::IndexedDaryHeap<int, 3> q(10);
+    std::vector<int> keys = {50, 20, 80, 10, 70, 30, 90, 60, 40, 0};
+    for (int id = 0; id < 9; ++id) {
+        q.push(id, keys[id]);
+    }
+    EXPECT_FALSE(q.contains(9));
+    q.decreaseKey(6, 5);	// 90 -> 5
+    q.decreaseKey(2, 25);	// 80 -> 25
+
+    std::vector<int> order;
+    while (!q.empty()) {
+        order.push_back(q.pop());
+    }
+    EXPECT_EQ(order, std::vector<int>({6, 3, 1, 2, 5, 8, 0, 7, 4}));
+    EXPECT_FALSE(q.contains(6));
+}
+
+TEST(GraphTests, KruskalAndBoruvkaMST)
+{
+    const int n = 3000;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::uniform_int_distribution<int> weight(-50, 1000);
+    std::vector<algo::Edge> edges;
+    // A few components, duplicate weights, and a self-loop.
+    for (int i = 0; i < 6 * n; ++i) {
+        int u = pick(rng);
+        int v = pick(rng);
+        if (u % 3 == v % 3) {
+            edges.push_back({u, v, weight(rng)});
+        }
+    }
+    edges.push_back({5, 5, -1000});
+    algo::MstResult expected =
+        algo::primMsf(algo::CsrGraph::fromEdges(n, edges, false));
+
+    algo::MstResult k = algo::kruskalMst(n, edges);
+    EXPECT_EQ(k.cost, expected.cost);
+    EXPECT_EQ(k.edges.size(), expected.edges.size());
+
+    for (int threads : {1, 3}) {
+        algo::ThreadPool pool(threads);
+        algo::MstResult b = algo::boruvkaMst(n, edges, pool);
+        EXPECT_EQ(b.cost, expected.cost);
+        EXPECT_EQ(b.edges.size(), expected.edges.size());
+        algo::UnionFind trees(n);
+        for (const auto& e : b.edges) {
+            EXPECT_TRUE(trees.unite(e.from, e.to));	// acyclic
+        }
+    }
+}
+
+TEST(UnionFindTests, UnionFind)
+{
+    algo::UnionFind uf(6);
+    EXPECT_TRUE(uf.unite(0, 1));
+    EXPECT_TRUE(uf.unite(2, 3));
+    EXPECT_TRUE(uf.unite(1, 3));
+    EXPECT_FALSE(uf.unite(0, 2));
+    EXPECT_TRUE(uf.same(0, 3));
+    EXPECT_FALSE(uf.same(0, 4));
+    EXPECT_EQ(uf.find(5), 5);
+}
+
+TEST(GraphTests, DijkstraAndDeltaStepping)
+{
+    // Random directed graph with zero weights and some unreachable vertices.
+    const int n = 4000;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, n - 21);
+    std::uniform_int_distribution<int> weight(0, 100000);
+    std::vector<algo::Edge> edges;
+    for (int i = 0; i < 5 * n; ++i) {
+        int w = weight(rng);
+        edges.push_back({pick(rng), pick(rng), w % 7 ? w : 0});
+    }
+    edges.push_back({0, n - 1, 0});
+    edges.push_back({n - 1, 0, 0});	// zero-weight cycle through the root
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(n, edges);
+
+    algo::ShortestPaths d = algo::dijkstra(g, 0);
+    EXPECT_EQ(d.dist[0], 0);
+    EXPECT_EQ(d.dist[n - 1], 0);
+    EXPECT_EQ(d.dist[n - 2], -1);
+    EXPECT_EQ(d.parent[n - 2], -1);
+
+    // Bellman-Ford style check: no edge can still be relaxed, and every
+    // reached vertex sits on a tight edge from its parent.
+    std::vector<bool> tight(n, false);
+    tight[0] = true;
+    for (const auto& e : edges) {
+        if (d.dist[e.from] >= 0) {
+            EXPECT_NE(d.dist[e.to], -1);
+            EXPECT_LE(d.dist[e.to], d.dist[e.from] + e.weight);
+            if (d.parent[e.to] == e.from
+                    && d.dist[e.to] == d.dist[e.from] + e.weight) {
+                tight[e.to] = true;
+            }
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        EXPECT_EQ(tight[v], d.dist[v] >= 0);
+    }
+
+    for (std::int64_t delta : {0, 1, 1000, 1 << 20}) {
+        algo::ThreadPool pool(3);
+        algo::ShortestPaths r = algo::deltaStepping(g, 0, pool, delta);
+        EXPECT_EQ(r.dist, d.dist);
+        // Predecessors form a tree of tight edges rooted at 0.
+        for (int v = 0; v < n; ++v) {
+            if (r.dist[v] <= 0) {
+                continue;
+            }
+            int steps = 0;
+            for (int u = v; u != 0 && steps <= n; u = r.parent[u]) {
+                ++steps;
+            }
+            EXPECT_LE(steps, n);
+        }
+    }
+
+    std::vector<algo::Edge> negative = {{0, 1, -1}};
+    algo::CsrGraph bad = algo::CsrGraph::fromEdges(2, negative);
+    algo::ThreadPool pool(1);
+    EXPECT_THROW(algo::dijkstra(bad, 0), std::invalid_argument);
+    EXPECT_THROW(algo::deltaStepping(bad, 0, pool), std::invalid_argument);
+}
+
+TEST(HeapTests, RadixHeap)
+{
+    algo::RadixHeap<int> q;
+    for (int key : {5, 3, 9, 3, 12, 1000000}) {
+        q.push(key, key * 10);
+    }
+    std::vector<std::uint64_t> keys;
+    keys.push_back(q.pop().first);
+    q.push(4, 40);	// not below the last popped key
+    while (!q.empty()) {
+        auto top = q.pop();
+        EXPECT_EQ(top.second, static_cast<int>(top.first) * 10);
+        keys.push_back(top.first);
+    }
+    EXPECT_EQ(keys, std::vector<std::uint64_t>({3, 3, 4, 5, 9, 12, 1000000}));
+}
+
+TEST(GraphTests, KahnTopologicalSort)
+{
+    // 0 -> 2, 1 -> 2, 2 -> 3, 1 -> 3, 4 isolated.
+    algo::CsrGraph dag = algo::CsrGraph::fromEdges(5,
+        std::vector<std::pair<int, int>>({{2, 3}, {0, 2}, {1, 3}, {1, 2}}));
+    algo::TopologicalOrder r = algo::kahnTopologicalSort(dag);
+    EXPECT_TRUE(r.acyclic());
+    EXPECT_EQ(r.order, std::vector<int>({0, 1, 4, 2, 3}));
+    ASSERT_EQ(r.numLevels(), 3);
+    EXPECT_EQ(std::vector<int>(r.level(0).begin(), r.level(0).end()),
+        std::vector<int>({0, 1, 4}));
+    EXPECT_EQ(r.level(1).size(), 1u);
+    EXPECT_EQ(r.level(2)[0], 3);
+
+    // Released as 3, 2 by 0 and 1, but listed in id order.
+    r = algo::kahnTopologicalSort(algo::CsrGraph::fromEdges(4,
+        std::vector<std::pair<int, int>>({{0, 3}, {1, 2}})));
+    EXPECT_EQ(r.order, std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(r.numLevels(), 2);
+
+    // 0 -> 1 -> 2 -> 3 -> 1 is a cycle, and 4 depends on it.
+    algo::CsrGraph cyclic = algo::CsrGraph::fromEdges(5,
+        std::vector<std::pair<int, int>>({{0, 1}, {1, 2}, {2, 3}, {3, 1},
+            {3, 4}}));
+    r = algo::kahnTopologicalSort(cyclic);
+    EXPECT_FALSE(r.acyclic());
+    EXPECT_EQ(r.order, std::vector<int>({0}));
+    EXPECT_EQ(r.cycle, std::vector<int>({1, 2, 3}));
+
+    algo::CsrGraph loop = algo::CsrGraph::fromEdges(2,
+        std::vector<std::pair<int, int>>({{1, 1}}));
+    EXPECT_EQ(algo::kahnTopologicalSort(loop).cycle, std::vector<int>({1}));
+}
+
+TEST(GraphTests, BitMatrix)
+{
+    algo::BitMatrix m(130);
+    EXPECT_EQ(m.rowWords(), 8u);	// padded to a cache line
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m.row(1)) % 64, 0u);
+    m.set(3, 129);
+    m.set(3, 0);
+    EXPECT_TRUE(m.test(3, 129));
+    EXPECT_FALSE(m.test(129, 3));
+    m.reset(3, 0);
+    EXPECT_EQ(m.numEdges(), 1u);
+}
+
+TEST(GraphTests, BitMatrixTraversalsMatchMatrix)
+{
+    // Random directed graph wider than one cache line of bits.
+    const int n = 700;
+    std::mt19937 rng(9);
+    std::vector<std::vector<int>> adj(n, std::vector<int>(n, 0));
+    for (int i = 0; i < 4 * n; ++i) {
+        adj[rng() % n][rng() % n] = 1;
+    }
+    algo::BitMatrix m = algo::BitMatrix::fromMatrix(adj);
+    algo::CsrGraph g = algo::CsrGraph::fromMatrix(adj);
+
+    for (int root : {0, 17, n - 1}) {
+        EXPECT_EQ(algo::bfs(m, root), algo::bfs(g, root));
+        EXPECT_EQ(algo::dfs(m, root), algo::dfs(g, root));
+        EXPECT_EQ(algo::rdfs(m, root), algo::rdfs(g, root));
+    }
+}
+
+TEST(GraphTests, CsrFileRoundTrip)
+{
+    const std::string path = testing::TempDir() + "roundtrip.csr";
+    algo::CsrGraph g = algo::CsrGraph::fromEdges(5,
+        std::vector<algo::Edge>({{0, 1, 4}, {1, 2, 3}, {3, 0, 9}}), false);
+    algo::saveCsr(g, path);
+
+    algo::CsrGraph loaded = algo::loadCsr(path, true);
+    EXPECT_EQ(loaded.numVertices(), 5);
+    EXPECT_TRUE(loaded.weighted());
+    EXPECT_EQ(asVector(loaded.offsets()), asVector(g.offsets()));
+    EXPECT_EQ(asVector(loaded.neighborArray()), asVector(g.neighborArray()));
+    EXPECT_EQ(asVector(loaded.weightArray()), asVector(g.weightArray()));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(loaded.neighborArray().begin()) % 64, 0u);
+    EXPECT_EQ(algo::bfs(loaded, 0), algo::bfs(g, 0));
+    EXPECT_EQ(algo::dijkstra(loaded, 3).dist, algo::dijkstra(g, 3).dist);
+
+    algo::saveCsr(algo::CsrGraph(), path);
+    EXPECT_EQ(algo::loadCsr(path).numVertices(), 0);
+
+    std::ofstream(path) << "0 1\n";
+    EXPECT_THROW(algo::loadCsr(path), std::runtime_error);
+    EXPECT_THROW(algo::loadCsr(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphTests, ConvertEdgeList)
+{
+    const std::string text = testing::TempDir() + "edges.txt";
+    const std::string path = testing::TempDir() + "edges.csr";
+    std::ofstream(text) << "# from to\n0 2\n\n% comment\n2 1\r\n 3 0 \n1 3";
+
+    algo::convertEdgeList(text, path);
+    algo::CsrGraph g = algo::loadCsr(path, true);
+    algo::CsrGraph expected = algo::CsrGraph::fromEdges(4,
+        std::vector<std::pair<int, int>>({{0, 2}, {2, 1}, {3, 0}, {1, 3}}));
+    EXPECT_FALSE(g.weighted());
+    EXPECT_EQ(asVector(g.offsets()), asVector(expected.offsets()));
+    EXPECT_EQ(asVector(g.neighborArray()), asVector(expected.neighborArray()));
+    EXPECT_EQ(algo::dfs(g, 0), algo::dfs(expected, 0));
+
+    std::ofstream(text) << "0 1 5\n1 2 -2\n";
+    algo::convertEdgeList(text, path, false);
+    g = algo::loadCsr(path);
+    expected = algo::CsrGraph::fromEdges(3,
+        std::vector<algo::Edge>({{0, 1, 5}, {1, 2, -2}}), false);
+    EXPECT_EQ(asVector(g.neighborArray()), asVector(expected.neighborArray()));
+    EXPECT_EQ(asVector(g.weightArray()), asVector(expected.weightArray()));
+
+    std::ofstream(text) << "0 1 5\n1 2\n";
+    EXPECT_THROW(algo::convertEdgeList(text, path), std::runtime_error);
+    std::ofstream(text) << "0 x\n";
+    EXPECT_THROW(algo::convertEdgeList(text, path), std::runtime_error);
+    std::remove(text.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(PrimeTests, PrimesUpTo)
+{
+    EXPECT_TRUE(algo::primesUpTo(1).empty());
+    EXPECT_EQ(algo::primesUpTo(2), std::vector<std::uint32_t>({2}));
+    EXPECT_EQ(algo::primesUpTo(30),
+              std::vector<std::uint32_t>({2, 3, 5, 7, 11, 13, 17, 19, 23, 29}));
+    EXPECT_EQ(algo::primesUpTo(1000000).size(), 78498u);
+}
+
+TEST(PrimeTests, SegmentedCountPrimes)
+{
+    EXPECT_EQ(algo::segmentedCountPrimes(0), 0u);
+    EXPECT_EQ(algo::segmentedCountPrimes(2), 1u);
+    EXPECT_EQ(algo::segmentedCountPrimes(3), 2u);
+    EXPECT_EQ(algo::segmentedCountPrimes(100), 25u);
+    EXPECT_EQ(algo::segmentedCountPrimes(10000000), 664579u);
+    EXPECT_EQ(algo::segmentedCountPrimes(100000000), 5761455u);
+
+    // Tiny segments, so primes and bounds fall on segment edges.
+    for (std::uint64_t n = 0; n < 600; ++n) {
+        EXPECT_EQ(algo::segmentedCountPrimes(n, 8),
+                  algo::primesUpTo(static_cast<std::uint32_t>(n)).size()) << n;
+    }
+}
+
+TEST(PrimeTests, ParallelSieve)
+{
+    for (int threads : {1, 3, 4}) {
+        algo::ThreadPool pool(threads);
+        EXPECT_EQ(algo::parallelCountPrimes(1, pool), 0u);
+        EXPECT_EQ(algo::parallelCountPrimes(2, pool), 1u);
+        EXPECT_EQ(algo::parallelCountPrimes(100000000, pool), 5761455u);
+        for (std::uint64_t n : {127u, 128u, 129u, 5000u, 65537u}) {
+            EXPECT_EQ(algo::parallelCountPrimes(n, pool, 8),
+                      algo::segmentedCountPrimes(n)) << n;
+        }
+
+        std::vector<std::uint32_t> small = algo::primesUpTo(200000);
+        std::vector<std::uint64_t> primes =
+            algo::parallelPrimes(0, 200000, pool, 64);
+        EXPECT_TRUE(std::equal(primes.begin(), primes.end(), small.begin(),
+                               small.end()));
+
+        primes = algo::parallelPrimes(1000000000000ull, 1000000001000ull, pool);
+        EXPECT_EQ(primes.size(), 37u);
+        EXPECT_EQ(primes.front(), 1000000000039ull);
+        EXPECT_TRUE(algo::parallelPrimes(24, 28, pool).empty());
+        EXPECT_EQ(algo::parallelPrimes(2, 3, pool),
+                  std::vector<std::uint64_t>({2, 3}));
+    }
+}
+
+TEST(PrimeTests, WheelSieve)
+{
+    for (std::uint64_t n = 0; n < 1000; ++n) {
+        EXPECT_EQ(algo::wheelCountPrimes(n),
+                  algo::primesUpTo(static_cast<std::uint32_t>(n)).size()) << n;
+    }
+    EXPECT_EQ(algo::wheelCountPrimes(100000000), 5761455u);
+    // Segments that start inside a pre-sieve period.
+    EXPECT_EQ(algo::wheelCountPrimes(10000000, 1000), 664579u);
+
+    algo::WheelSieve sieve(100000);
+    EXPECT_EQ(sieve.bytes().size(), 3334u);
+    EXPECT_EQ(sieve.count(), 9592u);
+    std::vector<std::uint32_t> primes = algo::primesUpTo(100000);
+    std::size_t next = 0;
+    for (std::uint64_t n = 0; n <= 100000; ++n) {
+        bool prime = next < primes.size() && primes[next] == n;
+        next += prime;
+        ASSERT_EQ(sieve.isPrime(n), prime) << n;
+    }
+    EXPECT_EQ(algo::WheelSieve(18).count(), 7u);
+    EXPECT_EQ(algo::WheelSieve(0).count(), 0u);
+}
+
+TEST(PrimeTests, MillerRabin)
+{
+    algo::WheelSieve sieve(200000);
+    for (std::uint64_t n = 0; n <= 200000; ++n) {
+        ASSERT_EQ(algo::isPrime(n), sieve.isPrime(n)) << n;
+    }
+
+    // Strong pseudoprimes to small bases, Carmichael numbers, squares and
+    // products of large primes.
+    for (std::uint64_t n : {2047ull, 1373653ull, 3215031751ull, 561ull,
+                            41041ull, 3825123056546413051ull,
+                            4759123141ull,
+                            4294967291ull * 4294967291ull,
+                            4294967291ull * 4294967279ull,
+                            18446744073709551615ull}) {
+        EXPECT_FALSE(algo::isPrime(n)) << n;
+    }
+    for (std::uint64_t n : {1000000007ull, 4294967291ull, 1000000000039ull,
+                            9223372036854775783ull, 18446744073709551557ull}) {
+        EXPECT_TRUE(algo::isPrime(n)) << n;
+    }
+    EXPECT_TRUE(algo::isPrime(97));
+    EXPECT_FALSE(algo::isPrime(-7));
+
+    // The batch form agrees with the scalar one, odd-sized tail included.
+    std::mt19937_64 rng(11);
+    std::vector<std::uint64_t> n(1001);
+    for (auto& x : n) {
+        x = rng() | 1;
+    }
+    for (std::size_t i = 0; i < 200; ++i) {
+        n[i] = 1000000000000ull + i;
+    }
+    n[500] = 3825123056546413051ull;
+    n[501] = 18446744073709551557ull;
+    std::unique_ptr<bool[]> out(new bool[n.size()]);
+    algo::isPrime(n.data(), n.size(), out.get());
+    for (std::size_t i = 0; i < n.size(); ++i) {
+        EXPECT_EQ(out[i], algo::isPrime(n[i])) << n[i];
+    }
+    algo::ThreadPool pool(1);
+    EXPECT_EQ(static_cast<std::size_t>(std::count(out.get(), out.get() + 200, true)),
+              algo::parallelPrimes(1000000000000ull, 1000000000199ull, pool).size());
+}
+
+TEST(PrimeTests, PrimePi)
+{
+    for (std::uint64_t x = 0; x < 2000; ++x) {
+        ASSERT_EQ(algo::primePi(x), algo::wheelCountPrimes(x)) << x;
+    }
+    std::mt19937_64 rng(13);
+    for (int i = 0; i < 20; ++i) {
+        std::uint64_t x = rng() % 10000000;
+        EXPECT_EQ(algo::primePi(x), algo::wheelCountPrimes(x)) << x;
+    }
+    // Squares of primes are where the sieving steps start.
+    for (std::uint64_t p : {997ull, 1009ull, 9973ull}) {
+        EXPECT_EQ(algo::primePi(p * p), algo::wheelCountPrimes(p * p)) << p;
+        EXPECT_EQ(algo::primePi(p * p - 1), algo::wheelCountPrimes(p * p - 1)) << p;
+    }
+    EXPECT_EQ(algo::primePi(10000000000ull), 455052511u);
+}
+
+TEST(PrimeTests, PrimeRange)
+{
+    std::vector<std::uint64_t> primes;
+    for (std::uint64_t p : algo::PrimeRange(0, 3000000)) {
+        primes.push_back(p);
+    }
+    std::vector<std::uint32_t> expected = algo::primesUpTo(3000000);
+    EXPECT_TRUE(std::equal(primes.begin(), primes.end(), expected.begin(),
+                           expected.end()));
+
+    algo::ThreadPool pool(1);
+    for (std::uint64_t first : {0ull, 1ull, 3ull, 6ull, 19ull, 29ull, 31ull,
+                                1000000000000ull, 281474976700000ull}) {
+        const std::uint64_t last = first + 30000;
+        primes.clear();
+        for (std::uint64_t p : algo::PrimeRange(first, last)) {
+            primes.push_back(p);
+        }
+        EXPECT_EQ(primes, algo::parallelPrimes(first, last, pool)) << first;
+    }
+
+    // Unbounded, stopped early, and up against the end of 64-bit range.
+    std::uint64_t count = 0;
+    for (std::uint64_t p : algo::PrimeRange(1000000000000000000ull)) {
+        EXPECT_TRUE(algo::isPrime(p));
+        if (++count == 10) {
+            break;
+        }
+    }
+    primes.clear();
+    for (std::uint64_t p : algo::PrimeRange(18446744073709551000ull)) {
+        primes.push_back(p);
+    }
+    ASSERT_FALSE(primes.empty());
+    EXPECT_EQ(primes.back(), 18446744073709551557ull);
+    EXPECT_TRUE(algo::PrimeRange(24, 28).begin() == algo::PrimeRange().end());
+    EXPECT_TRUE(algo::PrimeRange(10, 5).begin() == algo::PrimeRange().end());
+}
+
+// The tables are usable in constant expressions.
+static_assert(algo::primeTable<100>().size() == 25, "25 primes below 100");
+static_assert(algo::primeTable<100>()[24] == 97, "97 is the 25th prime");
+static_assert(algo::primeCount<3>() == 1 && algo::primeCount<2>() == 0,
+              "prime counts are strict");
+static_assert(algo::isSmallPrime(8191) && !algo::isSmallPrime(8193),
+              "table lookup");
+static_assert(algo::smallPrimeCount(100) == 25, "prefix counts");
+
+TEST(PrimeTests, CompileTimeTables)
+{
+    constexpr auto table = algo::primeTable<100000>();
+    std::vector<std::uint32_t> expected = algo::primesUpTo(99999);
+    EXPECT_TRUE(std::equal(table.begin(), table.end(), expected.begin(),
+                           expected.end()));
+
+    algo::WheelSieve sieve(algo::PRIME_TABLE_LIMIT);
+    std::uint32_t count = 0;
+    for (std::uint32_t n = 0; n < algo::PRIME_TABLE_LIMIT; ++n) {
+        count += sieve.isPrime(n);
+        ASSERT_EQ(algo::isSmallPrime(n), sieve.isPrime(n)) << n;
+        ASSERT_EQ(algo::smallPrimeCount(n), count) << n;
+    }
+    EXPECT_EQ(algo::countPrimes(static_cast<int>(algo::PRIME_TABLE_LIMIT) - 1),
+              static_cast<int>(count));
+    EXPECT_EQ(algo::countPrimes(static_cast<int>(algo::PRIME_TABLE_LIMIT)),
+              static_cast<int>(sieve.count()));
+}
+
+TEST(PrimeTests, PrimeIndex)
+{
+    const std::uint64_t limit = 2000003;
+    algo::PrimeIndex index(limit);
+    std::vector<std::uint32_t> primes = algo::primesUpTo(limit);
+    EXPECT_EQ(index.size(), primes.size());
+
+    for (std::size_t k = 0; k < primes.size(); k += 97) {
+        EXPECT_EQ(index.nth(k + 1), primes[k]) << k;
+    }
+    EXPECT_EQ(index.nth(1), 2u);
+    EXPECT_EQ(index.nth(4), 7u);
+    EXPECT_EQ(index.nth(primes.size()), primes.back());
+    EXPECT_THROW(index.nth(primes.size() + 1), std::out_of_range);
+    EXPECT_THROW(index.nth(0), std::out_of_range);
+
+    std::mt19937_64 rng(17);
+    for (int i = 0; i < 1000; ++i) {
+        std::uint64_t a = rng() % limit;
+        std::uint64_t b = a + rng() % (limit - a + 1);
+        auto first = std::lower_bound(primes.begin(), primes.end(), a);
+        auto last = std::upper_bound(primes.begin(), primes.end(), b);
+        ASSERT_EQ(index.count(a, b), static_cast<std::uint64_t>(last - first))
+            << a << " " << b;
+        auto next = std::upper_bound(primes.begin(), primes.end(), a);
+        if (next != primes.end()) {
+            ASSERT_EQ(index.next(a), *next) << a;
+        }
+        ASSERT_EQ(index.isPrime(a), first != primes.end() && *first == a) << a;
+    }
+    for (std::uint64_t n = 0; n < 40; ++n) {
+        EXPECT_EQ(index.count(0, n), algo::wheelCountPrimes(n)) << n;
+        EXPECT_EQ(index.next(n), *std::upper_bound(primes.begin(), primes.end(), n));
+    }
+    EXPECT_EQ(index.count(0, limit), index.size());
+    EXPECT_EQ(index.count(10, 5), 0u);
+    EXPECT_THROW(index.count(0, limit + 1), std::out_of_range);
+    EXPECT_THROW(index.next(primes.back()), std::out_of_range);
+
+    const std::string path = testing::TempDir() + "primes.idx";
+    index.save(path);
+    algo::PrimeIndex loaded = algo::PrimeIndex::load(path);
+    EXPECT_EQ(loaded.limit(), limit);
+    EXPECT_EQ(loaded.size(), index.size());
+    EXPECT_EQ(loaded.nth(100000), index.nth(100000));
+    EXPECT_EQ(loaded.count(1000, 1000000), index.count(1000, 1000000));
+    std::ofstream(path) << "not an index";
+    EXPECT_THROW(algo::PrimeIndex::load(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(algo::PrimeIndex(0).size(), 0u);
+    EXPECT_EQ(algo::PrimeIndex(5).nth(3), 5u);
+}
+
+TEST(SortTests, BottomUpMergeSort)
+{
+    std::mt19937 rng(19);
+    for (std::size_t n : {0u, 1u, 2u, 31u, 32u, 33u, 100u, 1000u, 4097u}) {
+        std::vector<int> v(n);
+        for (int& x : v) {
+            x = static_cast<int>(rng() % 1000) - 500;
+        }
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        algo::bottomUpMergeSort(v);
+        EXPECT_EQ(v, expected) << n;
+
+        algo::bottomUpMergeSort(v, std::greater<int>());
+        std::reverse(expected.begin(), expected.end());
+        EXPECT_EQ(v, expected) << n;
+    }
+
+    // Stable: equal keys keep their input order.
+    std::vector<std::pair<int, int>> v(5000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = {static_cast<int>(rng() % 50), static_cast<int>(i)};
+    }
+    std::vector<std::pair<int, int>> expected = v;
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    algo::bottomUpMergeSort(v, byKey);
+    EXPECT_EQ(v, expected);
+
+    std::vector<int> big(200000);
+    std::iota(big.begin(), big.end(), 0);
+    std::shuffle(big.begin(), big.end(), rng);
+    algo::mergeSort(big);
+    EXPECT_TRUE(std::is_sorted(big.begin(), big.end()));
+}
+
+TEST(SortTests, ParallelMergeSort)
+{
+    std::mt19937 rng(20);
+    algo::TaskPool pool(4);
+    const std::size_t grain = algo::PARALLEL_SORT_GRAIN;
+    for (std::size_t n : {std::size_t(0), grain, grain + 1, 5 * grain + 7}) {
+        std::vector<int> v(n);
+        for (int& x : v) {
+            x = static_cast<int>(rng() % 100000) - 50000;
+        }
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        algo::parallelMergeSort(v, pool);
+        EXPECT_EQ(v, expected) << n;
+
+        // Sorted and reversed inputs make the merge splits lopsided.
+        algo::parallelMergeSort(v, pool);
+        EXPECT_EQ(v, expected) << n;
+        algo::parallelMergeSort(v, pool, std::greater<int>());
+        std::reverse(expected.begin(), expected.end());
+        EXPECT_EQ(v, expected) << n;
+    }
+
+    // Stable across the parallel merges, with heavy ties on the split keys.
+    std::vector<std::pair<int, int>> v(6 * grain);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = {static_cast<int>(rng() % 8), static_cast<int>(i)};
+    }
+    std::vector<std::pair<int, int>> expected = v;
+    auto byKey = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    algo::parallelMergeSort(v, pool, byKey);
+    EXPECT_EQ(v, expected);
+
+    // Exceptions from the comparator reach the caller, and the pool still
+    // works afterwards.
+    std::vector<int> w(4 * grain);
+    std::iota(w.rbegin(), w.rend(), 0);
+    std::atomic<int> calls(0);
+    EXPECT_THROW(algo::parallelMergeSort(w, pool, [&](int a, int b) {
+        if (++calls == 50000) {
+            throw std::runtime_error("comparator");
+        }
+        return a < b;
+    }), std::runtime_error);
+    std::iota(w.rbegin(), w.rend(), 0);
+    algo::parallelMergeSort(w, pool);
+    EXPECT_TRUE(std::is_sorted(w.begin(), w.end()));
+}
+
+template <typename K>
+void checkRadixSort(std::mt19937_64& rng, std::size_t n, int shift)
+{
+    std::vector<K> v(n);
+    for (K& x : v) {
+        x = static_cast<K>(rng() >> shift);
+    }
+    std::vector<K> expected = v;
+    std::sort(expected.begin(), expected.end());
+    algo::radixSort(v);
+    EXPECT_EQ(v, expected) << n << " " << shift;
+}
+
+TEST(SortTests, RadixSort)
+{
+    std::mt19937_64 rng(21);
+    for (std::size_t n : {0u, 1u, 2u, 100u, 5000u}) {
+        // Full width, and narrow keys that skip the high digits.
+        for (int shift : {0, 40, 60}) {
+            checkRadixSort<std::int32_t>(rng, n, shift);
+            checkRadixSort<std::uint32_t>(rng, n, shift);
+            checkRadixSort<std::int64_t>(rng, n, shift);
+            checkRadixSort<std::uint64_t>(rng, n, shift);
+        }
+    }
+
+    std::vector<int> v = {5, -1, std::numeric_limits<int>::min(), 0,
+                          std::numeric_limits<int>::max(), -1, 7};
+    algo::radixSort(v);
+    EXPECT_EQ(v, (std::vector<int>{std::numeric_limits<int>::min(), -1, -1, 0,
+                                   5, 7, std::numeric_limits<int>::max()}));
+
+    // Every key equal: every pass is skipped.
+    std::vector<std::int64_t> same(1000, -42);
+    algo::radixSort(same);
+    EXPECT_EQ(same, std::vector<std::int64_t>(1000, -42));
+
+    // Payloads follow their keys, equal keys in input order.
+    std::vector<std::int64_t> keys(3000);
+    std::vector<std::string> values(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<std::int64_t>(rng() % 100) - 50;
+        values[i] = std::to_string(keys[i]) + ":" + std::to_string(i);
+    }
+    std::vector<std::pair<std::int64_t, std::string>> expected;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        expected.emplace_back(keys[i], values[i]);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    algo::radixSort(keys, values);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(keys[i], expected[i].first);
+        EXPECT_EQ(values[i], expected[i].second);
+    }
+
+    std::vector<int> shortValues(1);
+    EXPECT_THROW(algo::radixSort(keys, shortValues), std::invalid_argument);
+}
+
+template <std::size_t N>
+void checkNetwork()
+{
+    // 0-1 principle: a network sorts everything if it sorts all 0-1 inputs.
+    for (unsigned bits = 0; bits < (1u << N); ++bits) {
+        std::array<int, N> a;
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = (bits >> i) & 1;
+        }
+        algo::networkSort(a);
+        if (!std::is_sorted(a.begin(), a.end())) {
+            ADD_FAILURE() << "N = " << N << ", input " << bits;
+            return;
+        }
+    }
+}
+
+template <std::size_t... N>
+void checkNetworks(std::index_sequence<N...>)
+{
+    (checkNetwork<N>(), ...);
+}
+
+TEST(SortTests, NetworkSort)
+{
+    checkNetworks(std::make_index_sequence<algo::NETWORK_MAX + 1>());
+
+    std::array<std::string, 7> words = {"pear", "fig", "apple", "kiwi", "date",
+                                        "plum", "lime"};
+    algo::networkSort(words, std::greater<>());
+    EXPECT_EQ(words, (std::array<std::string, 7>{"plum", "pear", "lime", "kiwi",
+                                                 "fig", "date", "apple"}));
+
+    // Part of a range, ordered by a projection.
+    std::vector<int> v = {9, -3, 8, -1, 2, 0};
+    algo::networkSort<4>(v.begin() + 1, std::less<>(),
+                         [](int x) { return x * x; });
+    EXPECT_EQ(v, (std::vector<int>{9, -1, 2, -3, 8, 0}));
+}
+
+namespace {
+    struct Record {
+        int key;
+        int seq;
+        std::string name;
+    };
+
+    /**
+     * Random-access iterator over a vector that throws std::out_of_range
+     * as soon as it is moved outside [begin, end] or dereferenced at end,
+     * where a plain iterator would silently be undefined behavior.
+     */
+    template <typename T>
+    class CheckedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        CheckedIterator() = default;
+
+        CheckedIterator(std::vector<T>& v, difference_type i)
+            : v_(&v), i_(check(i)) {}
+
+        T& operator*() const
+        {
+            if (i_ == size()) {
+                throw std::out_of_range("dereferenced end");
+            }
+            return (*v_)[i_];
+        }
+
+        T& operator[](difference_type n) const { return *(*this + n); }
+
+        CheckedIterator& operator+=(difference_type n)
+        {
+            i_ = check(i_ + n);
+            return *this;
+        }
+
+        CheckedIterator& operator-=(difference_type n) { return *this += -n; }
+        CheckedIterator& operator++() { return *this += 1; }
+        CheckedIterator& operator--() { return *this -= 1; }
+
+        CheckedIterator operator++(int)
+        {
+            CheckedIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        CheckedIterator operator--(int)
+        {
+            CheckedIterator old = *this;
+            --*this;
+            return old;
+        }
+
+        friend CheckedIterator operator+(CheckedIterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend CheckedIterator operator+(difference_type n, CheckedIterator it)
+        {
+            return it += n;
+        }
+
+        friend CheckedIterator operator-(CheckedIterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const CheckedIterator& a,
+                                         const CheckedIterator& b)
+        {
+            return a.i_ - b.i_;
+        }
+
+        friend bool operator==(const CheckedIterator& a,
+                               const CheckedIterator& b)
+        {
+            return a.i_ == b.i_;
+        }
+
+        friend bool operator!=(const CheckedIterator& a,
+                               const CheckedIterator& b)
+        {
+            return a.i_ != b.i_;
+        }
+
+        friend bool operator<(const CheckedIterator& a,
+                              const CheckedIterator& b)
+        {
+            return a.i_ < b.i_;
+        }
+
+        friend bool operator>(const CheckedIterator& a,
+                              const CheckedIterator& b)
+        {
+            return b < a;
+        }
+
+        friend bool operator<=(const CheckedIterator& a,
+                               const CheckedIterator& b)
+        {
+            return !(b < a);
+        }
+
+        friend bool operator>=(const CheckedIterator& a,
+                               const CheckedIterator& b)
+        {
+            return !(a < b);
+        }
+
+    private:
+        difference_type size() const
+        {
+            return static_cast<difference_type>(v_->size());
+        }
+
+        difference_type check(difference_type i) const
+        {
+            if (i < 0 || i > size()) {
+                throw std::out_of_range("iterator outside [begin, end]");
+            }
+            return i;
+        }
+
+        std::vector<T>* v_ = nullptr;
+        difference_type i_ = 0;
+    };
+}
+
+TEST(SortTests, GenericSorts)
+{
+    // A deque is random access but not contiguous, and Record is not
+    // trivially copyable.
+    std::mt19937 rng(22);
+    std::deque<Record> records(3 * algo::PARALLEL_SORT_GRAIN);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        int key = static_cast<int>(rng() % 100);
+        records[i] = {key, static_cast<int>(i), std::to_string(key)};
+    }
+    auto stableOrder = [](const Record& a, const Record& b) {
+        return a.key != b.key ? a.key < b.key : a.seq < b.seq;
+    };
+    auto check = [&](const std::deque<Record>& sorted) {
+        EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), stableOrder));
+    };
+
+    std::deque<Record> d = records;
+    algo::bottomUpMergeSort(d.begin(), d.end(), std::less<>(), &Record::key);
+    check(d);
+
+    algo::TaskPool pool(3);
+    d = records;
+    algo::parallelMergeSort(d.begin(), d.end(), pool, std::less<>(),
+                            &Record::key);
+    check(d);
+
+    d.assign(records.begin(), records.begin() + 300);
+    algo::bubbleSort(d.begin(), d.end(), std::less<>(), &Record::key);
+    check(d);
+
+    d.assign(records.begin(), records.begin() + 300);
+    algo::selectionSort(d.begin(), d.end(), std::greater<>(), &Record::name);
+    EXPECT_TRUE(std::is_sorted(d.begin(), d.end(),
+                               [](const Record& a, const Record& b) {
+                                   return a.name > b.name;
+                               }));
+
+    // Plain arrays through pointers, descending.
+    int a[] = {5, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+    algo::bottomUpMergeSort(std::begin(a), std::end(a), std::greater<>());
+    EXPECT_TRUE(std::is_sorted(std::begin(a), std::end(a), std::greater<>()));
+}
+
+template <typename T>
+void checkSimdSort(std::mt19937_64& rng)
+{
+    // Sizes around the block and vector widths, with narrow ranges for
+    // duplicates and the extremes of T.
+    for (std::size_t n : {2u, 7u, 15u, 16u, 17u, 33u, 63u, 64u, 65u, 100u,
+                          1000u, 4099u, 100000u}) {
+        for (std::uint64_t range : {std::uint64_t(3), std::uint64_t(0)}) {
+            std::vector<T> v(n);
+            for (T& x : v) {
+                x = static_cast<T>(range ? rng() % range : rng());
+            }
+            v[0] = std::numeric_limits<T>::max();
+            v[n - 1] = std::numeric_limits<T>::min();
+            std::vector<T> expected = v;
+            std::sort(expected.begin(), expected.end());
+
+            std::vector<T> w = v;
+            algo::bottomUpMergeSort(w);
+            EXPECT_EQ(w, expected) << n;
+            algo::bottomUpMergeSort(w);
+            EXPECT_EQ(w, expected) << n;
+
+            // The scalar fallback sorts the same way.
+            w = v;
+            algo::bottomUpMergeSort(w, [](T a, T b) { return a < b; });
+            EXPECT_EQ(w, expected) << n;
+
+            // Merging the two sorted halves of an odd split.
+            std::size_t mid = n / 3;
+            w = v;
+            std::sort(w.begin(), w.begin() + mid);
+            std::sort(w.begin() + mid, w.end());
+            std::vector<T> out(n);
+            if (algo::detail::simdMerge(w.data(), w.data() + mid,
+                                        w.data() + mid, w.data() + n,
+                                        out.data())) {
+                EXPECT_EQ(out, expected) << n;
+            }
+        }
+    }
+}
+
+TEST(SortTests, SimdSort)
+{
+    std::mt19937_64 rng(23);
+    checkSimdSort<std::int32_t>(rng);
+    checkSimdSort<std::int64_t>(rng);
+    if (!algo::simdSortSupported()) {
+        GTEST_SKIP() << "no AVX2, checked the scalar code only";
+    }
+}
+
+TEST(SortTests, PdqSort)
+{
+    std::mt19937 rng(24);
+    const std::size_t n = 100000;
+    std::vector<std::pair<const char*, std::vector<int>>> inputs;
+    auto add = [&](const char* name, auto value) {
+        std::vector<int> v(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            v[i] = value(i);
+        }
+        inputs.emplace_back(name, std::move(v));
+    };
+    add("random", [&](std::size_t) { return static_cast<int>(rng()); });
+    add("sorted", [](std::size_t i) { return static_cast<int>(i); });
+    add("reversed", [](std::size_t i) { return static_cast<int>(n - i); });
+    add("equal", [](std::size_t) { return 7; });
+    add("few", [&](std::size_t) { return static_cast<int>(rng() % 4); });
+    add("organ pipe", [](std::size_t i) {
+        return static_cast<int>(std::min(i, n - i));
+    });
+    add("sawtooth", [](std::size_t i) { return static_cast<int>(i % 1000); });
+    add("sorted + noise", [&](std::size_t i) {
+        return static_cast<int>(rng() % 100 == 0 ? rng() % n : i);
+    });
+
+    for (const auto& input : inputs) {
+        std::vector<int> expected = input.second;
+        std::sort(expected.begin(), expected.end());
+        std::vector<int> v = input.second;
+        algo::pdqSort(v);
+        EXPECT_EQ(v, expected) << input.first;
+
+        // Not trivially copyable: the partition without blocks.
+        std::vector<std::string> s(input.second.size());
+        std::transform(input.second.begin(), input.second.end(), s.begin(),
+                       [](int x) { return std::to_string(x); });
+        algo::pdqSort(s, std::less<>(), [](const std::string& x) {
+            return std::stoi(x);
+        });
+        EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(),
+                               [](const std::string& x, int y) {
+                                   return std::stoi(x) == y;
+                               })) << input.first;
+    }
+
+    // Sorted, reversed and all-equal input are found out in linear time.
+    for (std::size_t i : {1u, 2u, 3u}) {
+        std::vector<int> v = inputs[i].second;
+        std::size_t comparisons = 0;
+        algo::pdqSort(v, [&](int a, int b) {
+            ++comparisons;
+            return a < b;
+        });
+        EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+        EXPECT_LT(comparisons, 4 * n) << inputs[i].first;
+    }
+
+    // Small sizes, descending, and a projection.
+    for (std::size_t m = 0; m < 200; ++m) {
+        std::vector<int> v(m);
+        for (int& x : v) {
+            x = static_cast<int>(rng() % 50);
+        }
+        algo::pdqSort(v.begin(), v.end(), std::greater<>());
+        EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>())) << m;
+    }
+    std::deque<Record> d(5000);
+    for (Record& r : d) {
+        r.key = static_cast<int>(rng() % 100);
+    }
+    algo::pdqSort(d.begin(), d.end(), std::less<>(), &Record::key);
+    EXPECT_TRUE(std::is_sorted(d.begin(), d.end(),
+                               [](const Record& a, const Record& b) {
+                                   return a.key < b.key;
+                               }));
+
+    // Equal keys land pivots at the ends of partitions, leaving empty
+    // ranges; no iterator may step outside the input on the way.
+    for (const auto& input : inputs) {
+        for (std::size_t m : {std::size_t(0), std::size_t(1), std::size_t(30),
+                              std::size_t(1000), n}) {
+            std::vector<int> v(input.second.begin(),
+                               input.second.begin() + m);
+            EXPECT_NO_THROW(algo::pdqSort(CheckedIterator<int>(v, 0),
+                                          CheckedIterator<int>(v, m)))
+                << input.first << " " << m;
+            EXPECT_TRUE(std::is_sorted(v.begin(), v.end()))
+                << input.first << " " << m;
+        }
+    }
+}
+
+template <typename T>
+void writeArray(const std::string& path, const std::vector<T>& v)
+{
+    std::ofstream(path, std::ios::binary).write(
+        reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <typename T>
+std::vector<T> readArray(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<T> v(static_cast<std::size_t>(file.tellg()) / sizeof(T));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(T));
+    return v;
+}
+
+TEST(SortTests, ExternalSort)
+{
+    const std::string in = testing::TempDir() + "unsorted.bin";
+    const std::string out = testing::TempDir() + "sorted.bin";
+    std::mt19937_64 rng(25);
+    std::vector<std::int32_t> v(300000);
+    for (auto& x : v) {
+        x = static_cast<std::int32_t>(rng());
+    }
+    std::vector<std::int32_t> expected = v;
+    std::sort(expected.begin(), expected.end());
+    writeArray(in, v);
+
+    // 64 KiB of buffers for 1.2 MB: dozens of runs, more than one merge
+    // pass, with and without the background I/O.
+    for (bool overlap : {false, true}) {
+        algo::ExternalSortOptions options;
+        options.memoryBytes = 64 << 10;
+        options.overlapIo = overlap;
+        algo::ExternalSortStats stats = algo::externalSort<std::int32_t>(
+            in, out, options);
+        EXPECT_EQ(stats.elements, v.size());
+        EXPECT_GT(stats.runs, 10u);
+        EXPECT_GT(stats.mergePasses, 1);
+        EXPECT_EQ(readArray<std::int32_t>(out), expected) << overlap;
+    }
+
+    // Fits in memory, in place, and 64-bit unsigned.
+    algo::ExternalSortStats stats = algo::externalSort<std::int32_t>(in, out);
+    EXPECT_EQ(stats.runs, 1u);
+    EXPECT_EQ(stats.mergePasses, 0);
+    EXPECT_EQ(readArray<std::int32_t>(out), expected);
+
+    std::vector<std::uint64_t> w(20000);
+    for (auto& x : w) {
+        x = rng();
+    }
+    writeArray(in, w);
+    algo::ExternalSortOptions options;
+    options.memoryBytes = 32 << 10;
+    options.tempDir = testing::TempDir();
+    algo::externalSort<std::uint64_t>(in, in, options);
+    std::sort(w.begin(), w.end());
+    EXPECT_EQ(readArray<std::uint64_t>(in), w);
+
+    writeArray(in, std::vector<std::int64_t>());
+    EXPECT_EQ(algo::externalSort<std::int64_t>(in, out).runs, 0u);
+    EXPECT_TRUE(readArray<std::int64_t>(out).empty());
+
+    std::ofstream(in) << "12345";
+    EXPECT_THROW(algo::externalSort<std::int32_t>(in, out), std::runtime_error);
+    EXPECT_THROW(algo::externalSort<std::int32_t>(in + ".missing", out),
+                 std::runtime_error);
+    options.memoryBytes = 1024;
+    EXPECT_THROW(algo::externalSort<std::int32_t>(in, out, options),
+                 std::invalid_argument);
+    std::remove(in.c_str());
+    std::remove(out.c_str());
+}
+
 // Main function for running tests
 int main(int argc, char **argv)
 {
@@ -0,0 +1,1319 @@
+/**
+ * @file primes.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the prime sieves and prime counting.
+ */
+
+#include "primes.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algo;
+
+using namespace std;
+
+namespace {
+	/** Cache sizes the segment size is picked between. */
+	const size_t L1_BYTES = 32 << 10;
+	const size_t L2_BYTES = 256 << 10;
+
+	/** floor(sqrt(n)), exact for all 64-bit n. */
+	uint64_t isqrt(uint64_t n)
+	{
+		uint64_t r = static_cast<uint64_t>(sqrtl(static_cast<long double>(n)));
+		while (r > 0 && r > n / r) {
+			--r;
+		}
+		while ((r + 1) <= n / (r + 1)) {
+			++r;
+		}
+		return r;
+	}
+
+	/** Segment size in words for sieving up to n, see segmentedCountPrimes(). */
+	size_t segmentWords(uint64_t n, size_t segmentBytes)
+	{
+		if (segmentBytes == 0) {
+			uint64_t bytes = isqrt(n) / 16;
+			segmentBytes = static_cast<size_t>(
+				min<uint64_t>(max<uint64_t>(bytes, L1_BYTES), L2_BYTES));
+		}
+		return (segmentBytes + 7) / 8;
+	}
+
+	/**
+	 * Sieve of Eratosthenes over the odd numbers of consecutive segments.
+	 *
+	 * Bit i of a segment starting at low (even) stands for low + 2i + 1 and
+	 * is set if that number is prime. Each base prime remembers the bit of
+	 * its next odd multiple relative to the current segment, so moving on
+	 * to the next segment costs no divisions.
+	 */
+	class SegmentedSieve {
+	public:
+		/**
+		 * @param primes The base primes, which must include every prime up
+		 * to the square root of the largest number sieved.
+		 * @param low Start of the first segment; rounded down to even.
+		 * @param words Segment size in 64-bit words, so 128 numbers each.
+		 */
+		SegmentedSieve(const vector<uint32_t>& primes, uint64_t low,
+					   size_t words)
+			: primes_(primes), low_(low & ~uint64_t(1)), bits_(words, 0)
+		{
+			next_.reserve(primes.size());
+			for (uint32_t p : primes) {
+				if (p == 2) {
+					next_.push_back(0);
+					continue;
+				}
+				// First odd multiple of p at or above max(p^2, low).
+				uint64_t m = max<uint64_t>(uint64_t(p) * p,
+										   (low_ + p - 1) / p * p);
+				if (!(m & 1)) {
+					m += p;
+				}
+				next_.push_back((m - low_) / 2);
+			}
+		}
+
+		/** First number covered by the current segment. */
+		uint64_t low() const { return low_; }
+
+		/** Numbers covered by a segment. */
+		uint64_t span() const { return bits_.size() * 128; }
+
+		/** The current segment, sieved. */
+		const vector<uint64_t>& bits() const { return bits_; }
+
+		/** Sieves the segment [low(), low() + span()). */
+		void sieve()
+		{
+			fill(bits_.begin(), bits_.end(), ~uint64_t(0));
+			uint64_t* words = bits_.data();
+			const uint64_t size = bits_.size() * 64;
+			for (size_t k = 0; k < primes_.size(); ++k) {
+				const uint64_t p = primes_[k];
+				if (p == 2) {
+					continue;
+				}
+				uint64_t j = next_[k];
+				for (; j < size; j += p) {
+					words[j >> 6] &= ~(uint64_t(1) << (j & 63));
+				}
+				next_[k] = j - size;
+			}
+			if (low_ == 0) {
+				words[0] &= ~uint64_t(1);	// 1 is not prime
+			}
+		}
+
+		/** Sieves the segment after the current one. */
+		void advance()
+		{
+			low_ += span();
+			sieve();
+		}
+
+		/**
+		 * Calls fn(p) for every odd prime p of the current segment in
+		 * [first, last], in increasing order.
+		 */
+		template <typename Fn>
+		void forEachPrime(uint64_t first, uint64_t last, Fn fn) const
+		{
+			for (size_t w = 0; w < bits_.size(); ++w) {
+				for (uint64_t bits = bits_[w]; bits; bits &= bits - 1) {
+					uint64_t p = low_ + 2 * (w * 64 + __builtin_ctzll(bits)) + 1;
+					if (p > last) {
+						return;
+					}
+					if (p >= first) {
+						fn(p);
+					}
+				}
+			}
+		}
+
+		/** Number of odd primes in the current segment that are <= n. */
+		uint64_t count(uint64_t n) const
+		{
+			if (n <= low_) {
+				return 0;
+			}
+			uint64_t size = min<uint64_t>((n - low_ + 1) / 2,
+										  bits_.size() * 64);
+			uint64_t c = 0;
+			size_t full = size / 64;
+			for (size_t w = 0; w < full; ++w) {
+				c += __builtin_popcountll(bits_[w]);
+			}
+			if (size % 64) {
+				c += __builtin_popcountll(bits_[full]
+										  & ((uint64_t(1) << (size % 64)) - 1));
+			}
+			return c;
+		}
+
+	private:
+		const vector<uint32_t>& primes_;
+		uint64_t low_;
+		vector<uint64_t> bits_;
+		vector<uint64_t> next_;
+	};
+
+	/**
+	 * Splits the segments covering [low, high] into contiguous chunks for
+	 * the parallel sieves. Each chunk starts with O(sqrt(high)) divisions to
+	 * place the base primes, so chunks are kept at least sqrt(high) numbers
+	 * long; otherwise there are about 16 per thread for load balancing.
+	 */
+	struct Chunks {
+		Chunks(uint64_t low, uint64_t high, size_t words, int threads)
+			: first(low & ~uint64_t(1)), span(words * 128)
+		{
+			uint64_t segments = (high - first) / span + 1;
+			uint64_t minSegments = max<uint64_t>(1, isqrt(high) / span);
+			uint64_t count = max<uint64_t>(1, min<uint64_t>(
+				segments / minSegments, uint64_t(threads) * 16));
+			perChunk = (segments + count - 1) / count;
+			size = static_cast<size_t>((segments + perChunk - 1) / perChunk);
+		}
+
+		uint64_t start(size_t chunk) const
+		{
+			return first + chunk * perChunk * span;
+		}
+
+		uint64_t first;
+		uint64_t span;
+		uint64_t perChunk;	///< Segments per chunk.
+		size_t size;		///< Number of chunks.
+	};
+
+	/** The residues mod 30 that are coprime to 30, one per bit of a byte. */
+	const uint8_t WHEEL[8] = { 1, 7, 11, 13, 17, 19, 23, 29 };
+
+	/** Gaps between consecutive wheel residues, the last one wrapping to 31. */
+	const uint8_t WHEEL_GAP[8] = { 6, 4, 2, 4, 2, 4, 6, 2 };
+
+	/** Primes whose multiples are copied in from a pattern, not crossed off. */
+	const uint32_t PRESIEVE_PRIMES[] = { 7, 11, 13, 17 };
+
+	/** The pattern repeats every 7 * 11 * 13 * 17 bytes. */
+	const size_t PRESIEVE_BYTES = 7 * 11 * 13 * 17;
+
+	/** Lookup tables for the mod-30 wheel, built once on first use. */
+	struct WheelTables {
+		WheelTables()
+		{
+			fill(begin(index), end(index), -1);
+			for (int b = 0; b < 8; ++b) {
+				index[WHEEL[b]] = b;
+			}
+			// A prime p = 30a + WHEEL[r] crosses off p * q for q = 30j + WHEEL[i]
+			// in turn; the multiple sits at bit index[WHEEL[r] * WHEEL[i] % 30]
+			// and the next one is a * WHEEL_GAP[i] + step[r][i] bytes further.
+			for (int r = 0; r < 8; ++r) {
+				for (int i = 0; i < 8; ++i) {
+					int q = WHEEL[i];
+					int next = i < 7 ? WHEEL[i + 1] : 31;
+					mask[r][i] = ~(1 << index[WHEEL[r] * q % 30]);
+					step[r][i] = WHEEL[r] * next / 30 - WHEEL[r] * q / 30;
+				}
+			}
+			for (size_t k = 0; k < PRESIEVE_BYTES; ++k) {
+				uint8_t byte = 0;
+				for (int b = 0; b < 8; ++b) {
+					uint64_t v = 30 * k + WHEEL[b];
+					bool composite = false;
+					for (uint32_t p : PRESIEVE_PRIMES) {
+						composite |= v % p == 0;
+					}
+					byte |= !composite << b;
+				}
+				presieve[k] = byte;
+			}
+		}
+
+		int8_t index[30];	///< Bit of each residue, or -1.
+		uint8_t mask[8][8];
+		uint8_t step[8][8];
+		uint8_t presieve[PRESIEVE_BYTES];
+	};
+
+	const WheelTables& wheelTables()
+	{
+		static const WheelTables tables;
+		return tables;
+	}
+
+	/**
+	 * Sieve of Eratosthenes over the mod-30 wheel, one byte per 30 numbers
+	 * with bit b of byte k standing for 30k + WHEEL[b]. Consecutive runs of
+	 * bytes are sieved in turn; each base prime keeps the byte and wheel
+	 * position of its next multiple, so stepping from one multiple to the
+	 * next is an add and a table lookup.
+	 */
+	class WheelSegments {
+	public:
+		/**
+		 * @param primes Every prime up to the square root of the largest
+		 * number sieved; 2 to 17 are skipped.
+		 * @param first Index of the first byte to sieve.
+		 */
+		WheelSegments(const vector<uint32_t>& primes, uint64_t first)
+			: k_(first)
+		{
+			const WheelTables& t = wheelTables();
+			for (uint32_t p : primes) {
+				if (p <= PRESIEVE_PRIMES[3]) {
+					continue;
+				}
+				// Smallest q >= max(p, first * 30 / p) coprime to 30.
+				uint64_t low = first * 30;
+				uint64_t q = max<uint64_t>(p, low / p + (low % p != 0));
+				uint64_t j = q / 30;
+				int i = 0;
+				while (i < 8 && WHEEL[i] < q % 30) {
+					++i;
+				}
+				if (i == 8) {
+					i = 0;
+					++j;
+				}
+				uint64_t m;
+				if (__builtin_mul_overflow(uint64_t(p), 30 * j + WHEEL[i], &m)) {
+					continue;	// no multiple left below 2^64
+				}
+				multiples_.push_back({ m / 30 - first, p / 30,
+									   static_cast<uint8_t>(t.index[p % 30]),
+									   static_cast<uint8_t>(i) });
+			}
+		}
+
+		/** Index of the next byte to sieve. */
+		uint64_t position() const { return k_; }
+
+		/** Sieves the next size bytes into out. */
+		void sieve(uint8_t* out, size_t size)
+		{
+			const WheelTables& t = wheelTables();
+			// Pre-sieve: copy the pattern, starting at the right phase.
+			size_t at = k_ % PRESIEVE_BYTES;
+			for (size_t done = 0; done < size; ) {
+				size_t run = min(size - done, PRESIEVE_BYTES - at);
+				memcpy(out + done, t.presieve + at, run);
+				done += run;
+				at = 0;
+			}
+			if (k_ == 0) {
+				out[0] = (out[0] | 0x1e) & ~1;	// 7 to 17 are prime, 1 is not
+			}
+
+			for (auto& m : multiples_) {
+				const uint8_t* mask = t.mask[m.residue];
+				const uint8_t* step = t.step[m.residue];
+				const uint64_t a = m.stride;
+				uint64_t k = m.next;
+				int i = m.wheel;
+				while (k < size) {
+					out[k] &= mask[i];
+					k += a * WHEEL_GAP[i] + step[i];
+					i = (i + 1) & 7;
+				}
+				m.next = k - size;
+				m.wheel = static_cast<uint8_t>(i);
+			}
+			k_ += size;
+		}
+
+	private:
+		struct Multiple {
+			uint64_t next;		///< Byte of the next multiple, segment-relative.
+			uint32_t stride;	///< p / 30.
+			uint8_t residue;	///< Wheel index of p % 30.
+			uint8_t wheel;		///< Wheel index of the next multiplier.
+		};
+
+		vector<Multiple> multiples_;
+		uint64_t k_;
+	};
+
+	/**
+	 * Number of set bits in the wheel bytes [first, first + size) that
+	 * stand for numbers <= n; out starts at byte first.
+	 */
+	uint64_t countWheel(const uint8_t* out, uint64_t first, size_t size,
+						uint64_t n)
+	{
+		uint64_t full = n < 29 ? 0 : (n - 29) / 30 + 1;	// bytes all <= n
+		size_t whole = full <= first ? 0
+			: static_cast<size_t>(min<uint64_t>(full - first, size));
+		uint64_t c = 0;
+		size_t k = 0;
+		for (; k + 8 <= whole; k += 8) {
+			uint64_t w;
+			memcpy(&w, out + k, 8);
+			c += __builtin_popcountll(w);
+		}
+		for (; k < whole; ++k) {
+			c += __builtin_popcount(out[k]);
+		}
+		if (whole < size && first + whole == full) {
+			for (int b = 0; b < 8; ++b) {
+				if (30 * full + WHEEL[b] <= n) {
+					c += (out[whole] >> b) & 1;
+				}
+			}
+		}
+		return c;
+	}
+
+	/**
+	 * Odd primes for the trial-division prefilter of isPrime(). Divisibility
+	 * by p is tested as n * inverse(p) <= (2^64 - 1) / p (mod 2^64), which is
+	 * a multiply and a compare instead of a division.
+	 */
+	const uint32_t TRIAL_PRIMES[] = {
+		3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67,
+		71, 73, 79, 83, 89, 97
+	};
+
+	/** Every odd number below this that passes trial division is prime. */
+	const uint64_t TRIAL_LIMIT = 101 * 101;
+
+	/** Witnesses that make Miller-Rabin exact for every n < 2^64 (Sinclair). */
+	const uint64_t WITNESSES[] = {
+		2, 325, 9375, 28178, 450775, 9780504, 1795265022
+	};
+
+	/** Inverse of odd a modulo 2^64, by Newton's iteration. */
+	uint64_t inverse(uint64_t a)
+	{
+		uint64_t x = a;		// correct to 3 bits
+		for (int i = 0; i < 5; ++i) {
+			x *= 2 - a * x;	// doubles the correct bits
+		}
+		return x;
+	}
+
+	struct TrialDivisor {
+		uint64_t inverse;
+		uint64_t limit;
+	};
+
+	const TrialDivisor* trialDivisors()
+	{
+		static const struct Table {
+			Table()
+			{
+				for (size_t i = 0; i < sizeof TRIAL_PRIMES / sizeof *TRIAL_PRIMES;
+					 ++i) {
+					divisors[i] = { inverse(TRIAL_PRIMES[i]),
+									~uint64_t(0) / TRIAL_PRIMES[i] };
+				}
+			}
+
+			TrialDivisor divisors[sizeof TRIAL_PRIMES / sizeof *TRIAL_PRIMES];
+		} table;
+		return table.divisors;
+	}
+
+	enum class Trial { PRIME, COMPOSITE, UNKNOWN };
+
+	/** Settles n by trial division if it is small or has a small factor. */
+	Trial trialDivide(uint64_t n)
+	{
+		if (n < 2) {
+			return Trial::COMPOSITE;
+		}
+		if (!(n & 1)) {
+			return n == 2 ? Trial::PRIME : Trial::COMPOSITE;
+		}
+		const TrialDivisor* d = trialDivisors();
+		for (size_t i = 0; i < sizeof TRIAL_PRIMES / sizeof *TRIAL_PRIMES; ++i) {
+			if (n * d[i].inverse <= d[i].limit) {
+				return n == TRIAL_PRIMES[i] ? Trial::PRIME : Trial::COMPOSITE;
+			}
+		}
+		return n < TRIAL_LIMIT ? Trial::PRIME : Trial::UNKNOWN;
+	}
+
+	/**
+	 * Arithmetic modulo an odd n in Montgomery form, x stored as x * 2^64
+	 * mod n, so a modular multiply is three 64-bit multiplies and no
+	 * division.
+	 */
+	class Montgomery {
+	public:
+		explicit Montgomery(uint64_t n)
+			: n_(n), inv_(inverse(n)), one_(-n % n),
+			  r2_(static_cast<uint64_t>(static_cast<unsigned __int128>(one_)
+										* one_ % n))
+		{
+		}
+
+		uint64_t one() const { return one_; }
+
+		uint64_t minusOne() const { return n_ - one_; }
+
+		uint64_t to(uint64_t a) const { return mul(a % n_, r2_); }
+
+		/** a * b / 2^64 mod n, for a, b < n. */
+		uint64_t mul(uint64_t a, uint64_t b) const
+		{
+			unsigned __int128 t = static_cast<unsigned __int128>(a) * b;
+			uint64_t m = static_cast<uint64_t>(t) * inv_;
+			// t - m * n is divisible by 2^64, so only the high words differ.
+			uint64_t hi = static_cast<uint64_t>(t >> 64);
+			uint64_t mn = static_cast<uint64_t>(
+				(static_cast<unsigned __int128>(m) * n_) >> 64);
+			return hi >= mn ? hi - mn : hi - mn + n_;
+		}
+
+		/** a^e, with a and the result in Montgomery form. */
+		uint64_t pow(uint64_t a, uint64_t e) const
+		{
+			uint64_t x = one_;
+			for (; e; e >>= 1) {
+				if (e & 1) {
+					x = mul(x, a);
+				}
+				a = mul(a, a);
+			}
+			return x;
+		}
+
+	private:
+		uint64_t n_;
+		uint64_t inv_;
+		uint64_t one_;
+		uint64_t r2_;
+	};
+
+	/** Strong probable-prime test of odd n > 2 to every witness. */
+	bool millerRabin(uint64_t n)
+	{
+		const Montgomery mont(n);
+		const int s = __builtin_ctzll(n - 1);
+		const uint64_t d = (n - 1) >> s;
+		for (uint64_t a : WITNESSES) {
+			if (a % n == 0) {
+				continue;
+			}
+			uint64_t x = mont.pow(mont.to(a), d);
+			if (x == mont.one() || x == mont.minusOne()) {
+				continue;
+			}
+			int i = 1;
+			for (; i < s; ++i) {
+				x = mont.mul(x, x);
+				if (x == mont.minusOne()) {
+					break;
+				}
+			}
+			if (i == s) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Candidates tested side by side in the batch isPrime(). */
+	const int LANES = 4;
+
+	/**
+	 * millerRabin() on LANES numbers at once, to the witnesses [first,
+	 * last). Every step runs for all lanes in the same loop, so the
+	 * multiplies of different lanes are independent and overlap in the
+	 * pipeline instead of each waiting on the last. Exponents are walked
+	 * from the top bit of the longest; leading zero bits of a shorter one
+	 * just square one. Stops early once every lane is known composite.
+	 */
+	void millerRabin(const uint64_t* n, const uint64_t* first,
+					 const uint64_t* last, bool* out)
+	{
+		Montgomery mont[LANES] = { Montgomery(n[0]), Montgomery(n[1]),
+								   Montgomery(n[2]), Montgomery(n[3]) };
+		uint64_t d[LANES];
+		int s[LANES];
+		int maxS = 0;
+		uint64_t bits = 0;
+		for (int l = 0; l < LANES; ++l) {
+			s[l] = __builtin_ctzll(n[l] - 1);
+			d[l] = (n[l] - 1) >> s[l];
+			maxS = max(maxS, s[l]);
+			bits |= d[l];
+			out[l] = true;
+		}
+		const int top = 63 - __builtin_clzll(bits);
+
+		for (const uint64_t* a = first; a != last; ++a) {
+			uint64_t x[LANES];
+			uint64_t base[LANES];
+			for (int l = 0; l < LANES; ++l) {
+				x[l] = mont[l].one();
+				base[l] = mont[l].to(*a);
+			}
+			for (int b = top; b >= 0; --b) {
+				for (int l = 0; l < LANES; ++l) {
+					x[l] = mont[l].mul(x[l], x[l]);
+					uint64_t y = mont[l].mul(x[l], base[l]);
+					x[l] = (d[l] >> b) & 1 ? y : x[l];
+				}
+			}
+
+			bool done[LANES];
+			for (int l = 0; l < LANES; ++l) {
+				done[l] = *a % n[l] == 0 || x[l] == mont[l].one()
+					|| x[l] == mont[l].minusOne();
+			}
+			for (int i = 1; i < maxS; ++i) {
+				for (int l = 0; l < LANES; ++l) {
+					if (!done[l] && i < s[l]) {
+						x[l] = mont[l].mul(x[l], x[l]);
+						done[l] = x[l] == mont[l].minusOne();
+					}
+				}
+			}
+			bool any = false;
+			for (int l = 0; l < LANES; ++l) {
+				out[l] = out[l] && done[l];
+				any |= out[l];
+			}
+			if (!any) {
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Batches of LANES candidates for the interleaved millerRabin(), each
+	 * remembering where its results go. A short last batch is padded with
+	 * copies of its first entry.
+	 */
+	class LaneQueue {
+	public:
+		/** Batches to be tested against the witnesses [first, last). */
+		LaneQueue(const uint64_t* first, const uint64_t* last)
+			: first_(first), last_(last)
+		{
+		}
+
+		/** Queues n for out[i]; full batches are tested right away. */
+		template <typename Done>
+		void push(uint64_t n, size_t i, Done done)
+		{
+			n_[size_] = n;
+			index_[size_] = i;
+			if (++size_ == LANES) {
+				flush(done);
+			}
+		}
+
+		/**
+		 * Tests the queued candidates and calls done(n, i, prime) for
+		 * each.
+		 */
+		template <typename Done>
+		void flush(Done done)
+		{
+			if (size_ == 0) {
+				return;
+			}
+			for (int l = size_; l < LANES; ++l) {
+				n_[l] = n_[0];
+			}
+			bool prime[LANES];
+			millerRabin(n_, first_, last_, prime);
+			int size = size_;
+			size_ = 0;
+			for (int l = 0; l < size; ++l) {
+				done(n_[l], index_[l], prime[l]);
+			}
+		}
+
+	private:
+		const uint64_t* first_;
+		const uint64_t* last_;
+		uint64_t n_[LANES];
+		size_t index_[LANES];
+		int size_ = 0;
+	};
+
+	/**
+	 * Sieves [0, limit] into the limit / 30 + 1 wheel bytes at out, an L1
+	 * sized run at a time. Bits past limit are cleared, so they never count
+	 * as primes.
+	 */
+	void sieveWheel(uint64_t limit, uint8_t* out)
+	{
+		const uint64_t size = limit / 30 + 1;
+		const vector<uint32_t> primes =
+			primesUpTo(static_cast<uint32_t>(isqrt(limit)));
+		WheelSegments sieve(primes, 0);
+		while (sieve.position() < size) {
+			uint64_t first = sieve.position();
+			sieve.sieve(out + first,
+						static_cast<size_t>(min<uint64_t>(L1_BYTES, size - first)));
+		}
+		for (int b = 0; b < 8; ++b) {
+			if ((limit / 30) * 30 + WHEEL[b] > limit) {
+				out[size - 1] &= ~(1 << b);
+			}
+		}
+	}
+
+	/** Number of wheel residues <= r, for r in [0, 30). */
+	int wheelRank(uint64_t r)
+	{
+		int b = 0;
+		while (b < 8 && WHEEL[b] <= r) {
+			++b;
+		}
+		return b;
+	}
+
+	/** Number of the wheel primes 2, 3 and 5 that are <= n. */
+	uint64_t wheelPrimesUpTo(uint64_t n)
+	{
+		return (n >= 2) + (n >= 3) + (n >= 5);
+	}
+} // namespace
+
+vector<uint32_t> algo::primesUpTo(uint32_t limit)
+{
+	vector<uint32_t> primes;
+	if (limit < 2) {
+		return primes;
+	}
+	primes.push_back(2);
+	// composite[i] stands for 2i + 1.
+	vector<bool> composite(limit / 2 + 1, false);
+	for (uint64_t i = 1; 2 * i + 1 <= limit; ++i) {
+		if (composite[i]) {
+			continue;
+		}
+		uint64_t p = 2 * i + 1;
+		primes.push_back(static_cast<uint32_t>(p));
+		for (uint64_t j = p * p / 2; j < composite.size(); j += p) {
+			composite[j] = true;
+		}
+	}
+	return primes;
+}
+
+uint64_t algo::segmentedCountPrimes(uint64_t n, size_t segmentBytes)
+{
+	if (n < 2) {
+		return 0;
+	}
+	const vector<uint32_t> primes = primesUpTo(static_cast<uint32_t>(isqrt(n)));
+	SegmentedSieve sieve(primes, 0, segmentWords(n, segmentBytes));
+	uint64_t count = 1;	// 2
+	for (sieve.sieve(); ; sieve.advance()) {
+		count += sieve.count(n);
+		if (n - sieve.low() < sieve.span()) {
+			break;
+		}
+	}
+	return count;
+}
+
+uint64_t algo::parallelCountPrimes(uint64_t n, ThreadPool& pool,
+								   size_t segmentBytes)
+{
+	if (n < 2) {
+		return 0;
+	}
+	const vector<uint32_t> primes = primesUpTo(static_cast<uint32_t>(isqrt(n)));
+	const size_t words = segmentWords(n, segmentBytes);
+	const Chunks chunks(0, n, words, pool.size());
+	vector<uint64_t> counts(chunks.size, 0);
+
+	pool.parallelFor(0, chunks.size, 1, [&](int, size_t b, size_t e) {
+		for (size_t c = b; c < e; ++c) {
+			SegmentedSieve sieve(primes, chunks.start(c), words);
+			sieve.sieve();
+			uint64_t count = 0;
+			for (uint64_t s = 0; ; ) {
+				count += sieve.count(n);
+				if (++s == chunks.perChunk || n - sieve.low() < sieve.span()) {
+					break;
+				}
+				sieve.advance();
+			}
+			counts[c] = count;
+		}
+	});
+
+	uint64_t count = 1;	// 2
+	for (uint64_t c : counts) {
+		count += c;
+	}
+	return count;
+}
+
+vector<uint64_t> algo::parallelPrimes(uint64_t low, uint64_t high,
+									  ThreadPool& pool, size_t segmentBytes)
+{
+	vector<uint64_t> out;
+	if (high < 2 || low > high) {
+		return out;
+	}
+	const vector<uint32_t> primes =
+		primesUpTo(static_cast<uint32_t>(isqrt(high)));
+	const size_t words = segmentWords(high, segmentBytes);
+	const Chunks chunks(low, high, words, pool.size());
+	vector<vector<uint64_t>> found(chunks.size);
+
+	pool.parallelFor(0, chunks.size, 1, [&](int, size_t b, size_t e) {
+		for (size_t c = b; c < e; ++c) {
+			SegmentedSieve sieve(primes, chunks.start(c), words);
+			sieve.sieve();
+			for (uint64_t s = 0; ; ) {
+				sieve.forEachPrime(low, high, [&](uint64_t p) {
+					found[c].push_back(p);
+				});
+				if (++s == chunks.perChunk
+						|| high - sieve.low() < sieve.span()) {
+					break;
+				}
+				sieve.advance();
+			}
+		}
+	});
+
+	// Concatenate the chunks in order, in parallel.
+	vector<size_t> at(chunks.size + 1, low <= 2 ? 1 : 0);
+	for (size_t c = 0; c < chunks.size; ++c) {
+		at[c + 1] = at[c] + found[c].size();
+	}
+	out.resize(at[chunks.size]);
+	if (low <= 2) {
+		out[0] = 2;
+	}
+	pool.parallelFor(0, chunks.size, 1, [&](int, size_t b, size_t e) {
+		for (size_t c = b; c < e; ++c) {
+			if (!found[c].empty()) {
+				memcpy(out.data() + at[c], found[c].data(),
+					   found[c].size() * sizeof(uint64_t));
+			}
+			vector<uint64_t>().swap(found[c]);
+		}
+	});
+	return out;
+}
+
+uint64_t algo::wheelCountPrimes(uint64_t n, size_t segmentBytes)
+{
+	if (n < 7) {
+		return wheelPrimesUpTo(n);
+	}
+	if (segmentBytes == 0) {
+		segmentBytes = static_cast<size_t>(min<uint64_t>(
+			max<uint64_t>(isqrt(n) / 30, L1_BYTES), L2_BYTES));
+	}
+	const vector<uint32_t> primes = primesUpTo(static_cast<uint32_t>(isqrt(n)));
+	const uint64_t bytes = n / 30 + 1;
+	WheelSegments sieve(primes, 0);
+	vector<uint8_t> segment(segmentBytes);
+	uint64_t count = wheelPrimesUpTo(n);
+	while (sieve.position() < bytes) {
+		uint64_t first = sieve.position();
+		size_t size = static_cast<size_t>(
+			min<uint64_t>(segmentBytes, bytes - first));
+		sieve.sieve(segment.data(), size);
+		count += countWheel(segment.data(), first, size, n);
+	}
+	return count;
+}
+
+algo::WheelSieve::WheelSieve(uint64_t limit)
+	: limit_(limit), bytes_(limit / 30 + 1)
+{
+	sieveWheel(limit, bytes_.data());
+}
+
+bool algo::WheelSieve::isPrime(uint64_t n) const
+{
+	int b = wheelTables().index[n % 30];
+	if (b < 0) {
+		return n == 2 || n == 3 || n == 5;
+	}
+	return (bytes_[n / 30] >> b) & 1;
+}
+
+uint64_t algo::WheelSieve::count() const
+{
+	return wheelPrimesUpTo(limit_)
+		+ countWheel(bytes_.data(), 0, bytes_.size(), limit_);
+}
+
+bool algo::isPrime(uint64_t n)
+{
+	if (n < PRIME_TABLE_LIMIT) {
+		return isSmallPrime(static_cast<uint32_t>(n));
+	}
+	Trial t = trialDivide(n);
+	return t == Trial::UNKNOWN ? millerRabin(n) : t == Trial::PRIME;
+}
+
+void algo::isPrime(const uint64_t* n, size_t count, bool* out)
+{
+	// Three stages: trial division settles small numbers and most
+	// composites; witness 2 alone weeds out nearly all remaining
+	// composites; only the probable primes left take the other witnesses.
+	// Batching the stages separately keeps composites from riding along
+	// through all seven witnesses with a prime in their batch.
+	const uint64_t* end = WITNESSES + sizeof WITNESSES / sizeof *WITNESSES;
+	LaneQueue rest(WITNESSES + 1, end);
+	LaneQueue base2(WITNESSES, WITNESSES + 1);
+
+	auto settle = [&](uint64_t, size_t i, bool prime) { out[i] = prime; };
+	auto passBase2 = [&](uint64_t x, size_t i, bool prime) {
+		if (prime) {
+			rest.push(x, i, settle);
+		} else {
+			out[i] = false;
+		}
+	};
+
+	for (size_t i = 0; i < count; ++i) {
+		Trial t = trialDivide(n[i]);
+		if (t == Trial::UNKNOWN) {
+			base2.push(n[i], i, passBase2);
+		} else {
+			out[i] = t == Trial::PRIME;
+		}
+	}
+	base2.flush(passBase2);
+	rest.flush(settle);
+}
+
+// Lucy_Hedgehog's method. S(v) starts as the count of [2, v]; sieving by
+// each prime p <= sqrt(x) in turn removes the numbers whose smallest prime
+// factor is p:
+//
+//     S(v) -= S(v / p) - S(p - 1)    for every tracked v >= p^2
+//
+// and afterwards S(v) = pi(v). Only the O(sqrt(x)) values floor(x / k) are
+// ever needed, stored as small[v] for v <= sqrt(x) and large[k] = S(x / k).
+uint64_t algo::primePi(uint64_t x)
+{
+	if (x < 2) {
+		return 0;
+	}
+	const uint64_t r = isqrt(x);
+	vector<uint64_t> small(r + 1);
+	vector<uint64_t> large(r + 1);
+	vector<uint64_t> quotient(r + 1);
+	small[0] = 0;
+	for (uint64_t v = 1; v <= r; ++v) {
+		small[v] = v - 1;
+	}
+	for (uint64_t k = 1; k <= r; ++k) {
+		quotient[k] = x / k;
+		large[k] = quotient[k] - 1;
+	}
+
+	for (uint64_t p = 2; p <= r; ++p) {
+		if (small[p] == small[p - 1]) {
+			continue;	// not prime
+		}
+		const uint64_t below = small[p - 1];	// pi(p - 1)
+		const uint64_t last = min(r, x / (p * p));
+
+		// Large v = x / k: x / (kp) is large while kp <= r, small after.
+		const uint64_t split = min(last, r / p);
+		for (uint64_t k = 1; k <= split; ++k) {
+			large[k] -= large[k * p] - below;
+		}
+		// floor(x / k / p) through a floating-point reciprocal, corrected
+		// by one either way, is much cheaper than a 64-bit division.
+		const double inv = 1.0 / p;
+		for (uint64_t k = split + 1; k <= last; ++k) {
+			uint64_t v = quotient[k];
+			uint64_t q = static_cast<uint64_t>(v * inv);
+			if (q * p > v) {
+				--q;
+			} else if ((q + 1) * p <= v) {
+				++q;
+			}
+			large[k] -= small[q] - below;
+		}
+
+		// Small v, from the top so small[v / p] is still the old value.
+		// v / p is constant over runs of p consecutive v, so no division.
+		for (uint64_t q = r / p; q >= p; --q) {
+			const uint64_t d = small[q] - below;
+			const uint64_t end = min(r, q * p + p - 1);
+			for (uint64_t v = q * p; v <= end; ++v) {
+				small[v] -= d;
+			}
+		}
+	}
+	return large[1];
+}
+
+/**
+ * Iteration state shared by the copies of a PrimeRange iterator: the
+ * current wheel segment and the position of the last prime in it.
+ *
+ * Segments are sieved with WheelSegments while the base primes up to the
+ * square root of the segment stay small (below 2^24, so bounds below 2^48);
+ * the table is extended and the sieve restarted whenever a segment needs
+ * more. Above that, sieving a segment would cost more in base primes than
+ * the segment is worth, so the wheel candidates of each segment are
+ * tested with the batch isPrime() instead.
+ */
+struct algo::PrimeRange::State {
+	/** Largest base prime the sieve is used with. */
+	static const uint32_t SIEVE_LIMIT = 1 << 24;
+
+	/** Bytes per segment when testing candidates one by one. */
+	static const size_t TEST_BYTES = 1 << 10;
+
+	State(uint64_t first, uint64_t last) : last(last), start(first)
+	{
+		if (first <= 5) {
+			for (uint64_t p : { 2, 3, 5 }) {
+				if (p >= first && p <= last) {
+					pending.push_back(p);
+				}
+			}
+		}
+		at = first / 30;
+		fill(at);
+		// Drop the candidates of the first byte that are below first.
+		for (int b = 0; b < 8; ++b) {
+			if (30 * at + WHEEL[b] < first) {
+				bits &= ~(1 << b);
+			}
+		}
+	}
+
+	/** Moves to the next prime; false when there is none left. */
+	bool next()
+	{
+		if (!pending.empty()) {
+			value = pending.front();
+			pending.erase(pending.begin());
+			return true;
+		}
+		while (true) {
+			if (bits) {
+				int b = __builtin_ctz(bits);
+				bits &= bits - 1;
+				// 30 * at + WHEEL[b] without overflowing near 2^64.
+				if (at > last / 30
+						|| (at == last / 30 && WHEEL[b] > last % 30)) {
+					return false;
+				}
+				value = 30 * at + WHEEL[b];
+				return true;
+			}
+			if (at >= last / 30) {
+				return false;
+			}
+			++at;
+			if (at - segment == bytes.size()) {
+				fill(at);
+			} else {
+				bits = bytes[at - segment];
+			}
+		}
+	}
+
+	/** Sieves or tests the segment starting at byte k. */
+	void fill(uint64_t k)
+	{
+		segment = k;
+		const uint64_t lastByte = last / 30;
+		uint64_t count = min<uint64_t>(L1_BYTES, lastByte - k + 1);
+		uint64_t high = lastByte - k + 1 > count
+			? 30 * (k + count) - 1 : last;
+		uint64_t root = isqrt(high);
+
+		if (root < SIEVE_LIMIT) {
+			if (!sieve || root > sieveLimit || sieve->position() != k) {
+				sieveLimit = max<uint64_t>(root, min<uint64_t>(
+					2 * sieveLimit, SIEVE_LIMIT - 1));
+				primes = primesUpTo(static_cast<uint32_t>(sieveLimit));
+				sieve.reset(new WheelSegments(primes, k));
+			}
+			bytes.resize(count);
+			sieve->sieve(bytes.data(), bytes.size());
+		} else {
+			sieve.reset();
+			vector<uint32_t>().swap(primes);
+			bytes.assign(min<uint64_t>(count, TEST_BYTES), 0);
+			vector<uint64_t> candidates(8 * bytes.size());
+			for (size_t i = 0; i < candidates.size(); ++i) {
+				// Wraps past 2^64 only beyond last, where it is ignored.
+				candidates[i] = 30 * (k + i / 8) + WHEEL[i % 8];
+			}
+			unique_ptr<bool[]> prime(new bool[candidates.size()]);
+			isPrime(candidates.data(), candidates.size(), prime.get());
+			for (size_t i = 0; i < candidates.size(); ++i) {
+				bytes[i / 8] |= prime[i] << (i % 8);
+			}
+		}
+		bits = bytes[0];
+	}
+
+	uint64_t last;
+	uint64_t start;
+	uint64_t value = 0;
+	vector<uint64_t> pending;	///< 2, 3 and 5, if in range.
+
+	vector<uint32_t> primes;
+	uint64_t sieveLimit = 0;
+	unique_ptr<WheelSegments> sieve;
+
+	vector<uint8_t> bytes;		///< The current segment.
+	uint64_t segment = 0;		///< Wheel byte of bytes[0].
+	uint64_t at = 0;			///< Wheel byte of the current prime.
+	unsigned bits = 0;			///< Candidates of byte at not yet visited.
+};
+
+const uint32_t algo::PrimeRange::State::SIEVE_LIMIT;
+const size_t algo::PrimeRange::State::TEST_BYTES;
+
+PrimeRange::iterator& algo::PrimeRange::iterator::operator++()
+{
+	if (!state_->next()) {
+		state_.reset();
+	}
+	return *this;
+}
+
+const uint64_t& algo::PrimeRange::iterator::operator*() const
+{
+	return state_->value;
+}
+
+PrimeRange::iterator algo::PrimeRange::begin() const
+{
+	iterator it;
+	if (first_ <= last_) {
+		it.state_ = make_shared<State>(first_, last_);
+		++it;
+	}
+	return it;
+}
+
+algo::PrimeIndex::PrimeIndex(uint64_t limit)
+	: limit_(limit), words_((limit / 30 + 1 + 7) / 8, 0)
+{
+	// The wheel bytes laid out in words, byte k in bits 8 (k % 8) and up of
+	// word k / 8 on a little-endian machine.
+	sieveWheel(limit, reinterpret_cast<uint8_t*>(words_.data()));
+	buildBlocks();
+}
+
+void algo::PrimeIndex::buildBlocks()
+{
+	blocks_.assign((words_.size() + BLOCK_WORDS - 1) / BLOCK_WORDS + 1, 0);
+	for (size_t w = 0; w < words_.size(); ++w) {
+		blocks_[w / BLOCK_WORDS + 1] += __builtin_popcountll(words_[w]);
+	}
+	for (size_t b = 1; b < blocks_.size(); ++b) {
+		blocks_[b] += blocks_[b - 1];
+	}
+}
+
+uint64_t algo::PrimeIndex::size() const
+{
+	return wheelPrimesUpTo(limit_) + blocks_.back();
+}
+
+uint64_t algo::PrimeIndex::rank(uint64_t bit) const
+{
+	const size_t word = static_cast<size_t>(bit / 64);
+	const size_t block = word / BLOCK_WORDS;
+	uint64_t count = blocks_[block];
+	for (size_t w = block * BLOCK_WORDS; w < word; ++w) {
+		count += __builtin_popcountll(words_[w]);
+	}
+	if (bit % 64) {
+		count += __builtin_popcountll(words_[word]
+									  & ((uint64_t(1) << (bit % 64)) - 1));
+	}
+	return count;
+}
+
+uint64_t algo::PrimeIndex::countUpTo(uint64_t n) const
+{
+	if (n > limit_) {
+		throw out_of_range("PrimeIndex: " + to_string(n) + " is past the limit");
+	}
+	return wheelPrimesUpTo(n) + rank(8 * (n / 30) + wheelRank(n % 30));
+}
+
+bool algo::PrimeIndex::isPrime(uint64_t n) const
+{
+	if (n > limit_) {
+		throw out_of_range("PrimeIndex: " + to_string(n) + " is past the limit");
+	}
+	int b = wheelTables().index[n % 30];
+	if (b < 0) {
+		return n == 2 || n == 3 || n == 5;
+	}
+	uint64_t bit = 8 * (n / 30) + b;
+	return (words_[bit / 64] >> (bit % 64)) & 1;
+}
+
+uint64_t algo::PrimeIndex::count(uint64_t a, uint64_t b) const
+{
+	if (a > b) {
+		return 0;
+	}
+	return countUpTo(b) - (a ? countUpTo(a - 1) : 0);
+}
+
+uint64_t algo::PrimeIndex::nth(uint64_t k) const
+{
+	if (k == 0 || k > size()) {
+		throw out_of_range("PrimeIndex: no prime number " + to_string(k)
+						   + " below the limit");
+	}
+	if (k <= 3) {
+		return k == 1 ? 2 : k == 2 ? 3 : 5;
+	}
+	uint64_t r = k - 4;	// rank among the wheel bits
+	// Last block that starts with at most r set bits before it.
+	size_t block = static_cast<size_t>(
+		upper_bound(blocks_.begin(), blocks_.end(), r) - blocks_.begin() - 1);
+	r -= blocks_[block];
+	size_t w = block * BLOCK_WORDS;
+	for (uint64_t c; (c = __builtin_popcountll(words_[w])) <= r; ++w) {
+		r -= c;
+	}
+	uint64_t bits = words_[w];
+	for (; r; --r) {
+		bits &= bits - 1;
+	}
+	uint64_t bit = 64 * w + __builtin_ctzll(bits);
+	return 30 * (bit / 8) + WHEEL[bit % 8];
+}
+
+uint64_t algo::PrimeIndex::next(uint64_t n) const
+{
+	for (uint64_t p : { 2, 3, 5 }) {
+		if (n < p && p <= limit_) {
+			return p;
+		}
+	}
+	if (n < limit_) {
+		uint64_t bit = 8 * (n / 30) + wheelRank(n % 30);
+		size_t w = static_cast<size_t>(bit / 64);
+		uint64_t bits = bit % 64 ? words_[w] & (~uint64_t(0) << (bit % 64))
+			: words_[w];
+		while (!bits && ++w < words_.size()) {
+			bits = words_[w];
+		}
+		if (bits) {
+			bit = 64 * w + __builtin_ctzll(bits);
+			return 30 * (bit / 8) + WHEEL[bit % 8];
+		}
+	}
+	throw out_of_range("PrimeIndex: no prime after " + to_string(n)
+					   + " below the limit");
+}
+
+namespace {
+	/** Header of a saved PrimeIndex, followed by its words. */
+	struct PrimeIndexHeader {
+		char magic[8];		///< "ALGOPIX" and a NUL.
+		uint32_t version;
+		uint32_t endianMark;
+		uint64_t limit;
+		uint64_t words;
+	};
+
+	const char PRIME_INDEX_MAGIC[8] = "ALGOPIX";
+
+	const uint32_t PRIME_INDEX_VERSION = 1;
+
+	const uint32_t PRIME_INDEX_ENDIAN_MARK = 0x01020304;
+
+	[[noreturn]] void failFile(const string& path, const string& what)
+	{
+		throw runtime_error(path + ": " + what);
+	}
+} // namespace
+
+void algo::PrimeIndex::save(const string& path) const
+{
+	PrimeIndexHeader h;
+	memset(&h, 0, sizeof h);
+	memcpy(h.magic, PRIME_INDEX_MAGIC, sizeof h.magic);
+	h.version = PRIME_INDEX_VERSION;
+	h.endianMark = PRIME_INDEX_ENDIAN_MARK;
+	h.limit = limit_;
+	h.words = words_.size();
+
+	unique_ptr<FILE, int (*)(FILE*)> file(fopen(path.c_str(), "wb"), fclose);
+	if (!file) {
+		failFile(path, string("fopen: ") + strerror(errno));
+	}
+	if (fwrite(&h, sizeof h, 1, file.get()) != 1
+			|| fwrite(words_.data(), sizeof(uint64_t), words_.size(),
+					  file.get()) != words_.size()) {
+		failFile(path, string("fwrite: ") + strerror(errno));
+	}
+	if (fclose(file.release()) != 0) {
+		failFile(path, string("fclose: ") + strerror(errno));
+	}
+}
+
+PrimeIndex algo::PrimeIndex::load(const string& path)
+{
+	unique_ptr<FILE, int (*)(FILE*)> file(fopen(path.c_str(), "rb"), fclose);
+	if (!file) {
+		failFile(path, string("fopen: ") + strerror(errno));
+	}
+	PrimeIndexHeader h;
+	if (fread(&h, sizeof h, 1, file.get()) != 1
+			|| memcmp(h.magic, PRIME_INDEX_MAGIC, sizeof h.magic) != 0) {
+		failFile(path, "not a prime index");
+	}
+	if (h.endianMark != PRIME_INDEX_ENDIAN_MARK) {
+		failFile(path, "written with a different byte order");
+	}
+	if (h.version != PRIME_INDEX_VERSION) {
+		failFile(path, "unsupported version " + to_string(h.version));
+	}
+	if (h.words != (h.limit / 30 + 1 + 7) / 8) {
+		failFile(path, "corrupt header");
+	}
+
+	PrimeIndex index;
+	index.limit_ = h.limit;
+	index.words_.resize(static_cast<size_t>(h.words));
+	if (fread(index.words_.data(), sizeof(uint64_t), index.words_.size(),
+			  file.get()) != index.words_.size()) {
+		failFile(path, "truncated");
+	}
+	index.buildBlocks();
+	return index;
+}
+
+// EOF
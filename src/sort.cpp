@@ -0,0 +1,881 @@
+/**
+ * @file sort.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Template implementations of the sorting algorithms, included from
+ * sort.hpp.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algo {
+	namespace detail {
+		template <typename It>
+		using ValueType = typename std::iterator_traits<It>::value_type;
+
+		/** comp(proj(x), proj(y)) as one comparator for the sorts below. */
+		template <typename Compare, typename Proj>
+		struct Projected {
+			Compare& comp;
+			Proj& proj;
+
+			template <typename A, typename B>
+			bool operator()(A&& a, B&& b)
+			{
+				return std::invoke(comp, std::invoke(proj, std::forward<A>(a)),
+								   std::invoke(proj, std::forward<B>(b)));
+			}
+		};
+
+		/**
+		 * True if the simd kernels can sort a range of It with comp: plain
+		 * ascending order of contiguous std::int32_t or std::int64_t. Equal
+		 * ints are indistinguishable, so stability does not matter.
+		 */
+		template <typename It, typename Compare>
+		constexpr bool simdSortable()
+		{
+			using T = ValueType<It>;
+			return (std::is_same<T, std::int32_t>::value
+					|| std::is_same<T, std::int64_t>::value)
+				&& (std::is_same<It, T*>::value
+					|| std::is_same<It, const T*>::value
+					|| std::is_same<It, typename std::vector<T>::iterator>::value
+					|| std::is_same<It,
+									typename std::vector<T>::const_iterator>::value)
+				&& (std::is_same<Compare, Projected<std::less<>, Identity>>::value
+					|| std::is_same<Compare,
+									Projected<std::less<T>, Identity>>::value);
+		}
+
+		/** Stable insertion sort of [first, last). */
+		template <typename It, typename Compare>
+		void insertionSort(It first, It last, Compare& comp)
+		{
+			if (first == last) {
+				return;
+			}
+			for (It i = first + 1; i < last; ++i) {
+				if (!comp(*i, *(i - 1))) {
+					continue;
+				}
+				ValueType<It> value = std::move(*i);
+				It j = i;
+				do {
+					*j = std::move(*(j - 1));
+					--j;
+				} while (j > first && comp(value, *(j - 1)));
+				*j = std::move(value);
+			}
+		}
+
+		/**
+		 * Number of comparators in Batcher's odd-even merge network for n
+		 * elements, which works for any n, not only powers of two.
+		 */
+		constexpr std::size_t networkSize(std::size_t n)
+		{
+			std::size_t size = 0;
+			for (std::size_t p = 1; p < n; p *= 2) {
+				for (std::size_t k = p; k >= 1; k /= 2) {
+					for (std::size_t j = k % p; j + k < n; j += 2 * k) {
+						for (std::size_t i = 0; i < k && i + j + k < n; ++i) {
+							if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+								++size;
+							}
+						}
+					}
+				}
+			}
+			return size;
+		}
+
+		/** A comparator of a network: orders the elements at a and b. */
+		struct NetworkPair {
+			unsigned char a;
+			unsigned char b;
+		};
+
+		/** The comparators counted by networkSize(N), in order. */
+		template <std::size_t N>
+		constexpr std::array<NetworkPair, networkSize(N)> makeNetwork()
+		{
+			std::array<NetworkPair, networkSize(N)> net{};
+			std::size_t at = 0;
+			for (std::size_t p = 1; p < N; p *= 2) {
+				for (std::size_t k = p; k >= 1; k /= 2) {
+					for (std::size_t j = k % p; j + k < N; j += 2 * k) {
+						for (std::size_t i = 0; i < k && i + j + k < N; ++i) {
+							if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+								net[at].a = static_cast<unsigned char>(i + j);
+								net[at].b = static_cast<unsigned char>(i + j + k);
+								++at;
+							}
+						}
+					}
+				}
+			}
+			return net;
+		}
+
+		template <std::size_t N>
+		inline constexpr auto NETWORK = makeNetwork<N>();
+
+		/**
+		 * Puts the smaller of *x and *y in *x. Trivially copyable values are
+		 * selected with conditional moves instead of a branch, which
+		 * mispredicts half the time on random input.
+		 */
+		template <typename It, typename Compare>
+		void compareExchange(It x, It y, Compare& comp)
+		{
+			using T = ValueType<It>;
+			if constexpr (std::is_trivially_copyable<T>::value) {
+				const T a = *x;
+				const T b = *y;
+				const bool swap = comp(b, a);
+				*x = swap ? b : a;
+				*y = swap ? a : b;
+			} else if (comp(*y, *x)) {
+				std::iter_swap(x, y);
+			}
+		}
+
+		template <std::size_t N, typename It, typename Compare,
+				  std::size_t... I>
+		void applyNetwork([[maybe_unused]] It first, Compare& comp,
+						  std::index_sequence<I...>)
+		{
+			(compareExchange(first + NETWORK<N>[I].a, first + NETWORK<N>[I].b,
+							 comp), ...);
+		}
+
+		/**
+		 * Stable merge of the sorted ranges [left, leftEnd) and
+		 * [right, rightEnd) into out; ties are taken from the left range.
+		 * Ranges that are already in order are moved instead of merged.
+		 */
+		template <typename In, typename Out, typename Compare>
+		void mergeInto(In left, In leftEnd, In right, In rightEnd, Out out,
+					   Compare& comp)
+		{
+			if (left == leftEnd || right == rightEnd
+					|| !comp(*right, *(leftEnd - 1))) {
+				out = std::move(left, leftEnd, out);
+				std::move(right, rightEnd, out);
+				return;
+			}
+			if constexpr (simdSortable<In, Compare>()
+						  && simdSortable<Out, Compare>()) {
+				if (simdMerge(&*left, &*left + (leftEnd - left), &*right,
+							  &*right + (rightEnd - right), &*out)) {
+					return;
+				}
+			}
+			if constexpr (std::is_trivially_copyable<ValueType<In>>::value) {
+				// Which side to take is data dependent, so select and
+				// advance arithmetically rather than branch on it.
+				while (left < leftEnd && right < rightEnd) {
+					const bool takeRight = comp(*right, *left);
+					*out++ = takeRight ? *right : *left;
+					right += takeRight;
+					left += !takeRight;
+				}
+			} else {
+				while (left < leftEnd && right < rightEnd) {
+					if (comp(*right, *left)) {
+						*out++ = std::move(*right++);
+					} else {
+						*out++ = std::move(*left++);
+					}
+				}
+			}
+			out = std::move(left, leftEnd, out);
+			std::move(right, rightEnd, out);
+		}
+
+		/** Merges each pair of adjacent width-element runs of src into dst. */
+		template <typename In, typename Out, typename Compare>
+		void mergePass(In src, Out dst, std::size_t n, std::size_t width,
+					   Compare& comp)
+		{
+			for (std::size_t i = 0; i < n; i += 2 * width) {
+				std::size_t mid = std::min(n, i + width);
+				std::size_t end = std::min(n, i + 2 * width);
+				mergeInto(src + i, src + mid, src + mid, src + end, dst + i,
+						  comp);
+			}
+		}
+
+		/**
+		 * Bottom-up merge sort of [data, data + n) using buffer, which has
+		 * room for n elements, as scratch.
+		 */
+		template <typename It, typename T, typename Compare>
+		void mergeSort(It data, T* buffer, std::size_t n, Compare& comp)
+		{
+			if constexpr (simdSortable<It, Compare>()) {
+				if (n > MERGE_RUN && simdMergeSort(&*data, buffer, n)) {
+					return;
+				}
+			}
+			for (std::size_t i = 0; i < n; i += MERGE_RUN) {
+				insertionSort(data + i, data + std::min(n, i + MERGE_RUN), comp);
+			}
+			bool inBuffer = false;
+			for (std::size_t width = MERGE_RUN; width < n; width *= 2) {
+				if (inBuffer) {
+					mergePass(buffer, data, n, width, comp);
+				} else {
+					mergePass(data, buffer, n, width, comp);
+				}
+				inBuffer = !inBuffer;
+			}
+			if (inBuffer) {
+				std::move(buffer, buffer + n, data);
+			}
+		}
+
+		/**
+		 * Merges [left, leftEnd) and [right, rightEnd) into out as tasks on
+		 * pool: the median of the longer range splits it, a binary search
+		 * for that element splits the other so that ties stay on the left,
+		 * and the two halves of the output are merged independently.
+		 */
+		template <typename In, typename Out, typename Compare>
+		void parallelMerge(TaskPool& pool, In left, In leftEnd, In right,
+						   In rightEnd, Out out, Compare& comp)
+		{
+			const std::size_t nl = leftEnd - left;
+			const std::size_t nr = rightEnd - right;
+			if (nl + nr <= PARALLEL_SORT_GRAIN) {
+				mergeInto(left, leftEnd, right, rightEnd, out, comp);
+				return;
+			}
+			In leftMid;
+			In rightMid;
+			if (nl >= nr) {
+				leftMid = left + nl / 2;
+				rightMid = std::lower_bound(right, rightEnd, *leftMid, comp);
+			} else {
+				rightMid = right + nr / 2;
+				leftMid = std::upper_bound(left, leftEnd, *rightMid, comp);
+			}
+			Out outMid = out + (leftMid - left) + (rightMid - right);
+			pool.invoke(
+				[&] { parallelMerge(pool, left, leftMid, right, rightMid, out,
+									comp); },
+				[&] { parallelMerge(pool, leftMid, leftEnd, rightMid, rightEnd,
+									outMid, comp); });
+		}
+
+		/**
+		 * Sorts [a, a + n) into a, or into b if intoB, with the two arrays
+		 * swapping roles at each level of the recursion so nothing is copied
+		 * back between merges.
+		 */
+		template <typename It, typename T, typename Compare>
+		void parallelMergeSort(TaskPool& pool, It a, T* b, std::size_t n,
+							   bool intoB, Compare& comp)
+		{
+			if (n <= PARALLEL_SORT_GRAIN) {
+				mergeSort(a, b, n, comp);
+				if (intoB) {
+					std::move(a, a + n, b);
+				}
+				return;
+			}
+			const std::size_t half = n / 2;
+			pool.invoke(
+				[&] { parallelMergeSort(pool, a, b, half, !intoB, comp); },
+				[&] { parallelMergeSort(pool, a + half, b + half, n - half,
+										!intoB, comp); });
+			if (intoB) {
+				parallelMerge(pool, a, a + half, a + half, a + n, b, comp);
+			} else {
+				parallelMerge(pool, b, b + half, b + half, b + n, a, comp);
+			}
+		}
+
+		/*
+		 * Pattern-defeating quicksort, after Orson Peters' pdqsort: sizes
+		 * below which ranges are insertion sorted and pivots are a median of
+		 * three instead of a ninther, the element moves after which a
+		 * speculative insertion sort gives up, and the block size of the
+		 * branchless partition.
+		 */
+		constexpr std::ptrdiff_t PDQ_INSERTION = 24;
+		constexpr std::ptrdiff_t PDQ_NINTHER = 128;
+		constexpr std::ptrdiff_t PDQ_PARTIAL_INSERTION = 8;
+		constexpr std::size_t PDQ_BLOCK = 64;
+
+		/**
+		 * Insertion sort of [first, last) that relies on *(first - 1) not
+		 * being greater than anything in the range to stop its inner loop.
+		 */
+		template <typename It, typename Compare>
+		void unguardedInsertionSort(It first, It last, Compare& comp)
+		{
+			if (first == last) {
+				return;
+			}
+			for (It i = first + 1; i < last; ++i) {
+				if (!comp(*i, *(i - 1))) {
+					continue;
+				}
+				ValueType<It> value = std::move(*i);
+				It j = i;
+				do {
+					*j = std::move(*(j - 1));
+					--j;
+				} while (comp(value, *(j - 1)));
+				*j = std::move(value);
+			}
+		}
+
+		/**
+		 * Insertion sort of [first, last) that gives up once it has moved
+		 * more than PDQ_PARTIAL_INSERTION elements.
+		 *
+		 * @return True if the range is sorted.
+		 */
+		template <typename It, typename Compare>
+		bool partialInsertionSort(It first, It last, Compare& comp)
+		{
+			if (first == last) {
+				return true;
+			}
+			std::ptrdiff_t moved = 0;
+			for (It i = first + 1; i < last; ++i) {
+				if (!comp(*i, *(i - 1))) {
+					continue;
+				}
+				ValueType<It> value = std::move(*i);
+				It j = i;
+				do {
+					*j = std::move(*(j - 1));
+					--j;
+				} while (j > first && comp(value, *(j - 1)));
+				*j = std::move(value);
+				moved += i - j;
+				if (moved > PDQ_PARTIAL_INSERTION) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template <typename It, typename Compare>
+		void sort2(It a, It b, Compare& comp)
+		{
+			if (comp(*b, *a)) {
+				std::iter_swap(a, b);
+			}
+		}
+
+		template <typename It, typename Compare>
+		void sort3(It a, It b, It c, Compare& comp)
+		{
+			sort2(a, b, comp);
+			sort2(b, c, comp);
+			sort2(a, b, comp);
+		}
+
+		/**
+		 * Partitions [first, last) around the pivot *first: smaller elements
+		 * to its left, equal and greater ones to its right.
+		 *
+		 * @pre Some element after first is not less than the pivot.
+		 *
+		 * @return Where the pivot ended up, and whether the range was
+		 * already partitioned.
+		 */
+		template <typename It, typename Compare>
+		std::pair<It, bool> partitionRight(It first, It last, Compare& comp)
+		{
+			ValueType<It> pivot = std::move(*first);
+			It l = first;
+			It r = last;
+			while (comp(*++l, pivot)) {
+			}
+			// Only guard the search if nothing below the pivot was found.
+			if (l - 1 == first) {
+				while (l < r && !comp(*--r, pivot)) {
+				}
+			} else {
+				while (!comp(*--r, pivot)) {
+				}
+			}
+			const bool alreadyPartitioned = l >= r;
+			while (l < r) {
+				std::iter_swap(l, r);
+				while (comp(*++l, pivot)) {
+				}
+				while (!comp(*--r, pivot)) {
+				}
+			}
+			It pivotAt = l - 1;
+			*first = std::move(*pivotAt);
+			*pivotAt = std::move(pivot);
+			return {pivotAt, alreadyPartitioned};
+		}
+
+		/**
+		 * partitionRight() without branches on the comparisons, after
+		 * Edelkamp and Weiss' BlockQuicksort: a block of elements from each
+		 * end is scanned, writing the offsets of those on the wrong side
+		 * unconditionally and advancing the count by the comparison result,
+		 * and then the misplaced elements are swapped pairwise. Worth it when
+		 * comparisons are cheap and their outcome is unpredictable.
+		 */
+		template <typename It, typename Compare>
+		std::pair<It, bool> partitionRightBlocks(It first, It last,
+												 Compare& comp)
+		{
+			ValueType<It> pivot = std::move(*first);
+			It l = first;
+			It r = last;
+			while (comp(*++l, pivot)) {
+			}
+			if (l - 1 == first) {
+				while (l < r && !comp(*--r, pivot)) {
+				}
+			} else {
+				while (!comp(*--r, pivot)) {
+				}
+			}
+			const bool alreadyPartitioned = l >= r;
+			if (!alreadyPartitioned) {
+				std::iter_swap(l, r);
+				++l;
+
+				alignas(64) unsigned char offsetsL[PDQ_BLOCK];
+				alignas(64) unsigned char offsetsR[PDQ_BLOCK];
+				It baseL = l;
+				It baseR = r;
+				std::size_t numL = 0;
+				std::size_t numR = 0;
+				std::size_t startL = 0;
+				std::size_t startR = 0;
+				while (l < r) {
+					// Refill whichever blocks are empty from the unscanned
+					// middle, splitting it if both are.
+					const std::size_t unknown = r - l;
+					const std::size_t splitL = numL == 0
+						? (numR == 0 ? unknown / 2 : unknown) : 0;
+					const std::size_t splitR = numR == 0 ? unknown - splitL : 0;
+					const std::size_t scanL = std::min(splitL, PDQ_BLOCK);
+					const std::size_t scanR = std::min(splitR, PDQ_BLOCK);
+					for (std::size_t i = 0; i < scanL; ++i) {
+						offsetsL[numL] = static_cast<unsigned char>(i);
+						numL += !comp(*l, pivot);
+						++l;
+					}
+					for (std::size_t i = 0; i < scanR; ++i) {
+						offsetsR[numR] = static_cast<unsigned char>(i + 1);
+						--r;
+						numR += comp(*r, pivot);
+					}
+
+					// Swap as many misplaced pairs as both blocks hold.
+					const std::size_t num = std::min(numL, numR);
+					for (std::size_t i = 0; i < num; ++i) {
+						std::iter_swap(baseL + offsetsL[startL + i],
+									   baseR - offsetsR[startR + i]);
+					}
+					numL -= num;
+					numR -= num;
+					startL += num;
+					startR += num;
+					if (numL == 0) {
+						startL = 0;
+						baseL = l;
+					}
+					if (numR == 0) {
+						startR = 0;
+						baseR = r;
+					}
+				}
+
+				// Everything is scanned; move what is left of the one block
+				// still holding misplaced elements to the boundary.
+				if (numL) {
+					while (numL--) {
+						std::iter_swap(baseL + offsetsL[startL + numL], --r);
+					}
+					l = r;
+				}
+				if (numR) {
+					while (numR--) {
+						std::iter_swap(baseR - offsetsR[startR + numR], l);
+						++l;
+					}
+					r = l;
+				}
+			}
+			It pivotAt = l - 1;
+			*first = std::move(*pivotAt);
+			*pivotAt = std::move(pivot);
+			return {pivotAt, alreadyPartitioned};
+		}
+
+		/**
+		 * Partitions [first, last) around the pivot *first with equal
+		 * elements to its left, for ranges where many equal the pivot.
+		 *
+		 * @return Where the pivot ended up.
+		 */
+		template <typename It, typename Compare>
+		It partitionLeft(It first, It last, Compare& comp)
+		{
+			ValueType<It> pivot = std::move(*first);
+			It l = first;
+			It r = last;
+			while (comp(pivot, *--r)) {
+			}
+			if (r + 1 == last) {
+				while (l < r && !comp(pivot, *++l)) {
+				}
+			} else {
+				while (!comp(pivot, *++l)) {
+				}
+			}
+			while (l < r) {
+				std::iter_swap(l, r);
+				while (comp(pivot, *--r)) {
+				}
+				while (!comp(pivot, *++l)) {
+				}
+			}
+			*first = std::move(*r);
+			*r = std::move(pivot);
+			return r;
+		}
+
+		/**
+		 * Sorts [first, last), recursing on the left part of each partition
+		 * and looping on the right. badAllowed counts down the highly
+		 * unbalanced partitions still tolerated before switching to
+		 * heapsort; leftmost is false if *(first - 1) bounds the range from
+		 * below.
+		 */
+		template <bool BLOCKS, typename It, typename Compare>
+		void pdqSort(It first, It last, Compare& comp, int badAllowed,
+					 bool leftmost)
+		{
+			for (;;) {
+				const std::ptrdiff_t size = last - first;
+				if (size < PDQ_INSERTION) {
+					if (leftmost) {
+						insertionSort(first, last, comp);
+					} else {
+						unguardedInsertionSort(first, last, comp);
+					}
+					return;
+				}
+
+				// Pivot to *first: a ninther for large ranges, which is far
+				// less likely to be skewed by a pattern in the input.
+				const std::ptrdiff_t half = size / 2;
+				if (size > PDQ_NINTHER) {
+					sort3(first, first + half, last - 1, comp);
+					sort3(first + 1, first + (half - 1), last - 2, comp);
+					sort3(first + 2, first + (half + 1), last - 3, comp);
+					sort3(first + (half - 1), first + half, first + (half + 1),
+						  comp);
+					std::iter_swap(first, first + half);
+				} else {
+					sort3(first + half, first, last - 1, comp);
+				}
+
+				// Nothing in the range is below *(first - 1), so a pivot equal
+				// to it is the smallest value: put all its copies on the left,
+				// where they are done, and go on with the rest.
+				if (!leftmost && !comp(*(first - 1), *first)) {
+					first = partitionLeft(first, last, comp) + 1;
+					continue;
+				}
+
+				std::pair<It, bool> part = BLOCKS
+					? partitionRightBlocks(first, last, comp)
+					: partitionRight(first, last, comp);
+				It pivotAt = part.first;
+				const std::ptrdiff_t sizeL = pivotAt - first;
+				const std::ptrdiff_t sizeR = last - (pivotAt + 1);
+
+				if (sizeL < size / 8 || sizeR < size / 8) {
+					if (--badAllowed == 0) {
+						std::make_heap(first, last, comp);
+						std::sort_heap(first, last, comp);
+						return;
+					}
+					// Break up whatever pattern caused it by swapping a few
+					// elements into different places.
+					if (sizeL >= PDQ_INSERTION) {
+						std::iter_swap(first, first + sizeL / 4);
+						std::iter_swap(pivotAt - 1, pivotAt - sizeL / 4);
+						if (sizeL > PDQ_NINTHER) {
+							std::iter_swap(first + 1, first + (sizeL / 4 + 1));
+							std::iter_swap(first + 2, first + (sizeL / 4 + 2));
+							std::iter_swap(pivotAt - 2, pivotAt - (sizeL / 4 + 1));
+							std::iter_swap(pivotAt - 3, pivotAt - (sizeL / 4 + 2));
+						}
+					}
+					if (sizeR >= PDQ_INSERTION) {
+						std::iter_swap(pivotAt + 1, pivotAt + (1 + sizeR / 4));
+						std::iter_swap(last - 1, last - sizeR / 4);
+						if (sizeR > PDQ_NINTHER) {
+							std::iter_swap(pivotAt + 2, pivotAt + (2 + sizeR / 4));
+							std::iter_swap(pivotAt + 3, pivotAt + (3 + sizeR / 4));
+							std::iter_swap(last - 2, last - (1 + sizeR / 4));
+							std::iter_swap(last - 3, last - (2 + sizeR / 4));
+						}
+					}
+				} else if (part.second
+						   && partialInsertionSort(first, pivotAt, comp)
+						   && partialInsertionSort(pivotAt + 1, last, comp)) {
+					// A balanced partition that swapped nothing suggests
+					// sorted input; a bounded insertion sort confirms it in
+					// linear time.
+					return;
+				}
+
+				pdqSort<BLOCKS>(first, pivotAt, comp, badAllowed, leftmost);
+				first = pivotAt + 1;
+				leftmost = false;
+			}
+		}
+
+		/** Key as an unsigned integer in the same order. */
+		template <typename K>
+		typename std::make_unsigned<K>::type radixKey(K key)
+		{
+			using U = typename std::make_unsigned<K>::type;
+			U u = static_cast<U>(key);
+			if constexpr (std::is_signed<K>::value) {
+				u ^= U(1) << (std::numeric_limits<U>::digits - 1);
+			}
+			return u;
+		}
+
+		/** Stands in for the values of a radix sort without any. */
+		struct NoValues {};
+
+		/**
+		 * Radix sort of keys[0, n), and values[0, n) with them unless V is
+		 * NoValues, using the buffers as scratch for n of each.
+		 */
+		template <typename K, typename V>
+		void radixSort(K* keys, K* keyBuffer, V* values, V* valueBuffer,
+					   std::size_t n)
+		{
+			using U = typename std::make_unsigned<K>::type;
+			constexpr bool hasValues = !std::is_same<V, NoValues>::value;
+			constexpr unsigned BITS = std::numeric_limits<U>::digits;
+			constexpr unsigned DIGITS = (BITS + RADIX_BITS - 1) / RADIX_BITS;
+			constexpr std::size_t BUCKETS = std::size_t(1) << RADIX_BITS;
+			constexpr U MASK = static_cast<U>(BUCKETS - 1);
+
+			std::vector<std::size_t> counts(DIGITS * BUCKETS, 0);
+			for (std::size_t i = 0; i < n; ++i) {
+				U u = radixKey(keys[i]);
+				for (unsigned d = 0; d < DIGITS; ++d) {
+					++counts[d * BUCKETS + ((u >> (d * RADIX_BITS)) & MASK)];
+				}
+			}
+
+			K* src = keys;
+			K* dst = keyBuffer;
+			V* srcValues = values;
+			V* dstValues = valueBuffer;
+			const U first = radixKey(keys[0]);
+			for (unsigned d = 0; d < DIGITS; ++d) {
+				const unsigned shift = d * RADIX_BITS;
+				std::size_t* count = &counts[d * BUCKETS];
+				if (count[(first >> shift) & MASK] == n) {
+					continue;	// every key has the same digit
+				}
+				std::size_t sum = 0;
+				for (std::size_t b = 0; b < BUCKETS; ++b) {
+					std::size_t c = count[b];
+					count[b] = sum;
+					sum += c;
+				}
+				for (std::size_t i = 0; i < n; ++i) {
+					std::size_t at = count[(radixKey(src[i]) >> shift) & MASK]++;
+					dst[at] = src[i];
+					if constexpr (hasValues) {
+						dstValues[at] = std::move(srcValues[i]);
+					}
+				}
+				std::swap(src, dst);
+				std::swap(srcValues, dstValues);
+			}
+
+			if (src != keys) {
+				std::copy(src, src + n, keys);
+				if constexpr (hasValues) {
+					std::move(srcValues, srcValues + n, values);
+				}
+			}
+		}
+	} // namespace detail
+
+	template <typename It, typename Compare, typename Proj>
+	void selectionSort(It first, It last, Compare comp, Proj proj)
+	{
+		detail::Projected<Compare, Proj> less{comp, proj};
+		for (It end = last; end - first > 1; --end) {
+			It largest = first;
+			// Don't loop what we've already sorted; all sorted is at end.
+			for (It i = first + 1; i < end; ++i) {
+				if (less(*largest, *i)) {
+					largest = i;
+				}
+			}
+			std::iter_swap(largest, end - 1);
+		}
+	}
+
+	template <typename It, typename Compare, typename Proj>
+	void bubbleSort(It first, It last, Compare comp, Proj proj)
+	{
+		detail::Projected<Compare, Proj> less{comp, proj};
+		bool sorted = false;
+		for (It end = last; !sorted && end - first > 1; --end) {
+			sorted = true;	// Assume sorted.
+			for (It i = first; i + 1 < end; ++i) {
+				if (less(*(i + 1), *i)) {
+					std::iter_swap(i, i + 1);
+					sorted = false;	// Not finished sorting, flag another pass.
+				}
+			}
+		}
+	}
+
+	template <std::size_t N, typename It, typename Compare, typename Proj>
+	void networkSort(It first, Compare comp, Proj proj)
+	{
+		static_assert(N <= NETWORK_MAX, "no sorting network of that size");
+		detail::Projected<Compare, Proj> less{comp, proj};
+		detail::applyNetwork<N>(first, less, std::make_index_sequence<
+								detail::NETWORK<N>.size()>());
+	}
+
+	template <typename T, std::size_t N, typename Compare, typename Proj>
+	void networkSort(std::array<T, N>& a, Compare comp, Proj proj)
+	{
+		networkSort<N>(a.begin(), comp, proj);
+	}
+
+	template <typename It, typename Compare, typename Proj>
+	void bottomUpMergeSort(It first, It last, Compare comp, Proj proj)
+	{
+		const std::size_t n = last - first;
+		if (n < 2) {
+			return;
+		}
+		detail::Projected<Compare, Proj> less{comp, proj};
+		std::vector<detail::ValueType<It>> buffer(n > MERGE_RUN ? n : 0);
+		detail::mergeSort(first, buffer.data(), n, less);
+	}
+
+	template <typename T, typename Compare, typename Proj>
+	void bottomUpMergeSort(std::vector<T>& v, Compare comp, Proj proj)
+	{
+		bottomUpMergeSort(v.begin(), v.end(), comp, proj);
+	}
+
+	template <typename It, typename Compare, typename Proj>
+	void parallelMergeSort(It first, It last, TaskPool& pool, Compare comp,
+						   Proj proj)
+	{
+		const std::size_t n = last - first;
+		if (n <= PARALLEL_SORT_GRAIN || pool.size() == 1) {
+			bottomUpMergeSort(first, last, comp, proj);
+			return;
+		}
+		detail::Projected<Compare, Proj> less{comp, proj};
+		std::vector<detail::ValueType<It>> buffer(n);
+		pool.run([&] {
+			detail::parallelMergeSort(pool, first, buffer.data(), n, false,
+									  less);
+		});
+	}
+
+	template <typename T, typename Compare, typename Proj>
+	void parallelMergeSort(std::vector<T>& v, TaskPool& pool, Compare comp,
+						   Proj proj)
+	{
+		parallelMergeSort(v.begin(), v.end(), pool, comp, proj);
+	}
+
+	template <typename It, typename Compare, typename Proj>
+	void pdqSort(It first, It last, Compare comp, Proj proj)
+	{
+		const std::size_t n = last - first;
+		if (n < 2) {
+			return;
+		}
+		detail::Projected<Compare, Proj> less{comp, proj};
+		int log2n = 0;
+		while (n >> (log2n + 1)) {
+			++log2n;
+		}
+		constexpr bool blocks =
+			std::is_trivially_copyable<detail::ValueType<It>>::value;
+		detail::pdqSort<blocks>(first, last, less, log2n, true);
+	}
+
+	template <typename T, typename Compare, typename Proj>
+	void pdqSort(std::vector<T>& v, Compare comp, Proj proj)
+	{
+		pdqSort(v.begin(), v.end(), comp, proj);
+	}
+
+	template <typename K>
+	void radixSort(std::vector<K>& keys)
+	{
+		static_assert(std::is_integral<K>::value && !std::is_same<K, bool>::value,
+					  "radixSort needs integer keys");
+		if (keys.size() < 2) {
+			return;
+		}
+		std::vector<K> buffer(keys.size());
+		detail::NoValues none;
+		detail::radixSort(keys.data(), buffer.data(), &none, &none,
+						  keys.size());
+	}
+
+	template <typename K, typename V>
+	void radixSort(std::vector<K>& keys, std::vector<V>& values)
+	{
+		static_assert(std::is_integral<K>::value && !std::is_same<K, bool>::value,
+					  "radixSort needs integer keys");
+		if (keys.size() != values.size()) {
+			throw std::invalid_argument("radixSort: keys and values differ in size");
+		}
+		if (keys.size() < 2) {
+			return;
+		}
+		std::vector<K> buffer(keys.size());
+		std::vector<V> valueBuffer(values.size());
+		detail::radixSort(keys.data(), buffer.data(), values.data(),
+						  valueBuffer.data(), keys.size());
+	}
+} // namespace algo
+
+// EOF
@@ -0,0 +1,409 @@
+/**
+ * @file sort_simd.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * AVX2 merge sort kernels for 32- and 64-bit ints, chosen at run time.
+ *
+ * Blocks are sorted in registers: a sorting network across the vectors
+ * sorts each lane's column, a transpose turns the columns into sorted runs
+ * of one vector each, and a bitonic merge joins pairs of those. Runs are
+ * then merged a vector at a time: the two vectors in hand go through a
+ * bitonic merge network, the lower half is stored, and the upper half is
+ * merged with the next vector from whichever input has the smaller head.
+ *
+ * The kernels are compiled for AVX2 with target attributes rather than
+ * -mavx2, so the library still runs on hosts without it, where the entry
+ * points return false and the callers sort with the scalar code.
+ */
+
+#include "sort.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ALGO_AVX2_SORT 1
+#endif
+
+using namespace algo;
+
+using namespace std;
+
+namespace {
+	/** Branchless scalar merge, for short inputs and the tails of long ones. */
+	template <typename E>
+	void scalarMerge(const E* a, const E* aEnd, const E* b, const E* bEnd,
+					 E* out)
+	{
+		while (a < aEnd && b < bEnd) {
+			const bool takeB = *b < *a;
+			*out++ = takeB ? *b : *a;
+			b += takeB;
+			a += !takeB;
+		}
+		out = copy(a, aEnd, out);
+		copy(b, bEnd, out);
+	}
+
+	template <typename E>
+	void insertionSort(E* first, E* last)
+	{
+		for (E* i = first + 1; i < last; ++i) {
+			E value = *i;
+			E* j = i;
+			for (; j > first && value < *(j - 1); --j) {
+				*j = *(j - 1);
+			}
+			*j = value;
+		}
+	}
+
+#ifdef ALGO_AVX2_SORT
+#define AVX2 __attribute__((target("avx2")))
+
+	/** Eight int32_t lanes. */
+	struct Lanes32 {
+		using E = int32_t;
+		static constexpr size_t LANES = 8;
+		static constexpr size_t BLOCK = 64;	///< Elements sorted in registers.
+		static constexpr size_t RUN = 16;	///< Sorted run length of a block.
+
+		AVX2 static __m256i min(__m256i a, __m256i b)
+		{
+			return _mm256_min_epi32(a, b);
+		}
+
+		AVX2 static __m256i max(__m256i a, __m256i b)
+		{
+			return _mm256_max_epi32(a, b);
+		}
+
+		AVX2 static __m256i reverse(__m256i v)
+		{
+			return _mm256_permutevar8x32_epi32(
+				v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+		}
+
+		/** Sorts a bitonic vector with half-cleaners at distance 4, 2, 1. */
+		AVX2 static __m256i sortBitonic(__m256i v)
+		{
+			__m256i t = _mm256_permute2x128_si256(v, v, 1);
+			v = _mm256_blend_epi32(min(v, t), max(v, t), 0xf0);
+			t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+			v = _mm256_blend_epi32(min(v, t), max(v, t), 0xcc);
+			t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+			return _mm256_blend_epi32(min(v, t), max(v, t), 0xaa);
+		}
+
+		/** Transposes the 8x8 matrix whose rows are r[0..8). */
+		AVX2 static void transpose(__m256i* r)
+		{
+			__m256i t[8];
+			for (int i = 0; i < 8; i += 2) {
+				t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+				t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+			}
+			__m256i u[8];
+			for (int i = 0; i < 8; i += 4) {
+				u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+				u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+				u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+				u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+			}
+			for (int i = 0; i < 4; ++i) {
+				r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+				r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+			}
+		}
+	};
+
+	/** Four int64_t lanes; AVX2 has no 64-bit min or max, so compare. */
+	struct Lanes64 {
+		using E = int64_t;
+		static constexpr size_t LANES = 4;
+		static constexpr size_t BLOCK = 16;
+		static constexpr size_t RUN = 8;
+
+		AVX2 static __m256i min(__m256i a, __m256i b)
+		{
+			return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+		}
+
+		AVX2 static __m256i max(__m256i a, __m256i b)
+		{
+			return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+		}
+
+		AVX2 static __m256i reverse(__m256i v)
+		{
+			return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+
+		/** Sorts a bitonic vector with half-cleaners at distance 2, 1. */
+		AVX2 static __m256i sortBitonic(__m256i v)
+		{
+			__m256i t = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+			v = _mm256_blend_epi32(min(v, t), max(v, t), 0xf0);
+			t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+			return _mm256_blend_epi32(min(v, t), max(v, t), 0xcc);
+		}
+
+		/** Transposes the 4x4 matrix whose rows are r[0..4). */
+		AVX2 static void transpose(__m256i* r)
+		{
+			__m256i t0 = _mm256_unpacklo_epi64(r[0], r[1]);
+			__m256i t1 = _mm256_unpackhi_epi64(r[0], r[1]);
+			__m256i t2 = _mm256_unpacklo_epi64(r[2], r[3]);
+			__m256i t3 = _mm256_unpackhi_epi64(r[2], r[3]);
+			r[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+			r[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+			r[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+			r[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+		}
+	};
+
+	AVX2 inline __m256i loadVector(const void* p)
+	{
+		return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+	}
+
+	AVX2 inline void storeVector(void* p, __m256i v)
+	{
+		_mm256_storeu_si256(static_cast<__m256i*>(p), v);
+	}
+
+	template <typename V>
+	AVX2 void compareExchange(__m256i& a, __m256i& b)
+	{
+		__m256i lo = V::min(a, b);
+		b = V::max(a, b);
+		a = lo;
+	}
+
+	/**
+	 * Merges the sorted vectors a and b: afterwards a holds the lower half
+	 * of their elements and b the upper half, both sorted.
+	 */
+	template <typename V>
+	AVX2 void bitonicMerge(__m256i& a, __m256i& b)
+	{
+		b = V::reverse(b);
+		__m256i lo = V::min(a, b);
+		__m256i hi = V::max(a, b);
+		a = V::sortBitonic(lo);
+		b = V::sortBitonic(hi);
+	}
+
+	/** Sorts V::BLOCK elements at p into runs of V::RUN. */
+	template <typename V>
+	AVX2 void sortBlock(typename V::E* p);
+
+	template <>
+	AVX2 void sortBlock<Lanes32>(int32_t* p)
+	{
+		using V = Lanes32;
+		__m256i r[8];
+		for (int i = 0; i < 8; ++i) {
+			r[i] = loadVector(p + 8 * i);
+		}
+		// Batcher's network for 8, down each column.
+		compareExchange<V>(r[0], r[1]);
+		compareExchange<V>(r[2], r[3]);
+		compareExchange<V>(r[4], r[5]);
+		compareExchange<V>(r[6], r[7]);
+		compareExchange<V>(r[0], r[2]);
+		compareExchange<V>(r[1], r[3]);
+		compareExchange<V>(r[4], r[6]);
+		compareExchange<V>(r[5], r[7]);
+		compareExchange<V>(r[1], r[2]);
+		compareExchange<V>(r[5], r[6]);
+		compareExchange<V>(r[0], r[4]);
+		compareExchange<V>(r[1], r[5]);
+		compareExchange<V>(r[2], r[6]);
+		compareExchange<V>(r[3], r[7]);
+		compareExchange<V>(r[2], r[4]);
+		compareExchange<V>(r[3], r[5]);
+		compareExchange<V>(r[1], r[2]);
+		compareExchange<V>(r[3], r[4]);
+		compareExchange<V>(r[5], r[6]);
+		V::transpose(r);
+		for (int i = 0; i < 8; i += 2) {
+			bitonicMerge<V>(r[i], r[i + 1]);
+		}
+		for (int i = 0; i < 8; ++i) {
+			storeVector(p + 8 * i, r[i]);
+		}
+	}
+
+	template <>
+	AVX2 void sortBlock<Lanes64>(int64_t* p)
+	{
+		using V = Lanes64;
+		__m256i r[4];
+		for (int i = 0; i < 4; ++i) {
+			r[i] = loadVector(p + 4 * i);
+		}
+		compareExchange<V>(r[0], r[1]);
+		compareExchange<V>(r[2], r[3]);
+		compareExchange<V>(r[0], r[2]);
+		compareExchange<V>(r[1], r[3]);
+		compareExchange<V>(r[1], r[2]);
+		V::transpose(r);
+		bitonicMerge<V>(r[0], r[1]);
+		bitonicMerge<V>(r[2], r[3]);
+		for (int i = 0; i < 4; ++i) {
+			storeVector(p + 4 * i, r[i]);
+		}
+	}
+
+	/** Vectorized merge of [a, aEnd) and [b, bEnd) into out. */
+	template <typename V>
+	AVX2 void vectorMerge(const typename V::E* a, const typename V::E* aEnd,
+					const typename V::E* b, const typename V::E* bEnd,
+					typename V::E* out)
+	{
+		using E = typename V::E;
+		constexpr size_t L = V::LANES;
+		if (a == aEnd || b == bEnd || !(*b < *(aEnd - 1))) {
+			out = copy(a, aEnd, out);	// already in order
+			copy(b, bEnd, out);
+			return;
+		}
+		if (static_cast<size_t>(aEnd - a) < L
+				|| static_cast<size_t>(bEnd - b) < L) {
+			scalarMerge(a, aEnd, b, bEnd, out);
+			return;
+		}
+
+		__m256i lo = loadVector(a);
+		__m256i hi = loadVector(b);
+		a += L;
+		b += L;
+		for (;;) {
+			bitonicMerge<V>(lo, hi);
+			storeVector(out, lo);
+			out += L;
+
+			// hi is not below anything stored yet; take the next vector from
+			// the input with the smaller head.
+			const bool takeA = a < aEnd && (b == bEnd || !(*b < *a));
+			if (!takeA && b == bEnd) {
+				storeVector(out, hi);
+				return;
+			}
+			const E*& next = takeA ? a : b;
+			const E* nextEnd = takeA ? aEnd : bEnd;
+			if (static_cast<size_t>(nextEnd - next) < L) {
+				// Too few left for a vector: finish hi and that input, then
+				// merge them with the rest of the other.
+				E held[L];
+				E tail[2 * L];
+				storeVector(held, hi);
+				scalarMerge(held, held + L, next, nextEnd, tail);
+				const E* other = takeA ? b : a;
+				const E* otherEnd = takeA ? bEnd : aEnd;
+				scalarMerge(tail, tail + L + (nextEnd - next), other, otherEnd,
+							out);
+				return;
+			}
+			lo = loadVector(next);
+			next += L;
+		}
+	}
+
+	/** Sorts data[0, n) with the vector kernels, buffer holding n more. */
+	template <typename V>
+	AVX2 void vectorSort(typename V::E* data, typename V::E* buffer, size_t n)
+	{
+		using E = typename V::E;
+		const size_t blocks = n / V::BLOCK * V::BLOCK;
+		for (size_t i = 0; i < blocks; i += V::BLOCK) {
+			sortBlock<V>(data + i);
+		}
+		insertionSort(data + blocks, data + n);
+
+		E* src = data;
+		E* dst = buffer;
+		for (size_t width = V::RUN; width < n; width *= 2) {
+			for (size_t i = 0; i < n; i += 2 * width) {
+				size_t mid = min(n, i + width);
+				size_t end = min(n, i + 2 * width);
+				vectorMerge<V>(src + i, src + mid, src + mid, src + end, dst + i);
+			}
+			swap(src, dst);
+		}
+		if (src != data) {
+			memcpy(data, src, n * sizeof(E));
+		}
+	}
+
+#undef AVX2
+#endif // ALGO_AVX2_SORT
+} // namespace
+
+bool algo::simdSortSupported()
+{
+#ifdef ALGO_AVX2_SORT
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+bool algo::detail::simdMergeSort(int32_t* data, int32_t* buffer, size_t n)
+{
+#ifdef ALGO_AVX2_SORT
+	if (simdSortSupported()) {
+		vectorSort<Lanes32>(data, buffer, n);
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool algo::detail::simdMergeSort(int64_t* data, int64_t* buffer, size_t n)
+{
+#ifdef ALGO_AVX2_SORT
+	if (simdSortSupported()) {
+		vectorSort<Lanes64>(data, buffer, n);
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool algo::detail::simdMerge(const int32_t* a, const int32_t* aEnd,
+							 const int32_t* b, const int32_t* bEnd,
+							 int32_t* out)
+{
+#ifdef ALGO_AVX2_SORT
+	if (simdSortSupported()) {
+		vectorMerge<Lanes32>(a, aEnd, b, bEnd, out);
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool algo::detail::simdMerge(const int64_t* a, const int64_t* aEnd,
+							 const int64_t* b, const int64_t* bEnd,
+							 int64_t* out)
+{
+#ifdef ALGO_AVX2_SORT
+	if (simdSortSupported()) {
+		vectorMerge<Lanes64>(a, aEnd, b, bEnd, out);
+		return true;
+	}
+#endif
+	return false;
+}
+
+// EOF
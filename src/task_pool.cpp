@@ -0,0 +1,205 @@
+/**
+ * @file task_pool.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the work-stealing thread pool.
+ */
+
+#include "task_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace algo;
+
+using namespace std;
+
+struct algo::TaskPool::Task {
+	const function<void()>* fn;
+	atomic<bool> done{false};
+	exception_ptr error;
+};
+
+namespace {
+	/** The pool the current thread is running a job for, and its tid. */
+	thread_local const TaskPool* currentPool = nullptr;
+	thread_local int currentTid = 0;
+} // namespace
+
+algo::TaskPool::TaskPool(int numThreads)
+{
+	if (numThreads <= 0) {
+		numThreads = max(1u, thread::hardware_concurrency());
+	}
+	queues_.reserve(numThreads);
+	for (int tid = 0; tid < numThreads; ++tid) {
+		queues_.push_back(make_unique<Queue>());
+	}
+	workers_.reserve(numThreads - 1);
+	for (int tid = 1; tid < numThreads; ++tid) {
+		workers_.emplace_back(&TaskPool::workerLoop, this, tid);
+	}
+}
+
+algo::TaskPool::~TaskPool()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stop_ = true;
+	}
+	start_.notify_all();
+	for (auto& t : workers_) {
+		t.join();
+	}
+}
+
+void algo::TaskPool::run(const function<void()>& fn)
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		busy_ = static_cast<int>(workers_.size());
+		active_.store(true, memory_order_release);
+		++generation_;
+	}
+	start_.notify_all();
+
+	// The caller is thread 0. Every task fn forks is joined before fn
+	// returns, so the workers only have to be told to stop looking.
+	currentPool = this;
+	currentTid = 0;
+	exception_ptr error;
+	try {
+		fn();
+	} catch (...) {
+		error = current_exception();
+	}
+	currentPool = nullptr;
+	active_.store(false, memory_order_release);
+
+	unique_lock<mutex> lock(mutex_);
+	done_.wait(lock, [this] { return busy_ == 0; });
+	lock.unlock();
+	if (error) {
+		rethrow_exception(error);
+	}
+}
+
+void algo::TaskPool::invoke(const function<void()>& a,
+							const function<void()>& b)
+{
+	if (currentPool != this) {
+		run([&] { invoke(a, b); });
+		return;
+	}
+
+	const int tid = currentTid;
+	Task task;
+	task.fn = &b;
+	{
+		lock_guard<mutex> lock(queues_[tid]->mutex);
+		queues_[tid]->tasks.push_back(&task);
+	}
+
+	exception_ptr error;
+	try {
+		a();
+	} catch (...) {
+		error = current_exception();
+	}
+
+	// Whatever a forked has been joined, so b is on top unless stolen.
+	if (pop(tid) == &task) {
+		execute(task);
+	} else {
+		while (!task.done.load(memory_order_acquire)) {
+			if (Task* t = steal(tid)) {
+				execute(*t);
+			} else {
+				this_thread::yield();
+			}
+		}
+	}
+
+	if (!error) {
+		error = task.error;
+	}
+	if (error) {
+		rethrow_exception(error);
+	}
+}
+
+void algo::TaskPool::execute(Task& t)
+{
+	try {
+		(*t.fn)();
+	} catch (...) {
+		t.error = current_exception();
+	}
+	t.done.store(true, memory_order_release);
+}
+
+TaskPool::Task* algo::TaskPool::pop(int tid)
+{
+	Queue& q = *queues_[tid];
+	lock_guard<mutex> lock(q.mutex);
+	if (q.tasks.empty()) {
+		return nullptr;
+	}
+	Task* t = q.tasks.back();
+	q.tasks.pop_back();
+	return t;
+}
+
+TaskPool::Task* algo::TaskPool::steal(int tid)
+{
+	const int n = size();
+	for (int i = 1; i < n; ++i) {
+		Queue& q = *queues_[(tid + i) % n];
+		lock_guard<mutex> lock(q.mutex);
+		if (!q.tasks.empty()) {
+			Task* t = q.tasks.front();
+			q.tasks.pop_front();
+			return t;
+		}
+	}
+	return nullptr;
+}
+
+void algo::TaskPool::workerLoop(int tid)
+{
+	currentPool = this;
+	currentTid = tid;
+	uint64_t seen = 0;
+	for (;;) {
+		{
+			unique_lock<mutex> lock(mutex_);
+			start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+			if (stop_) {
+				return;
+			}
+			seen = generation_;
+		}
+
+		while (active_.load(memory_order_acquire)) {
+			if (Task* t = steal(tid)) {
+				execute(*t);
+			} else {
+				this_thread::yield();
+			}
+		}
+
+		lock_guard<mutex> lock(mutex_);
+		if (--busy_ == 0) {
+			done_.notify_one();
+		}
+	}
+}
+
+// EOF
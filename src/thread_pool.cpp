@@ -0,0 +1,129 @@
+/**
+ * @file thread_pool.cpp
+ *
+ * @author Tyler Baxter
+ * @version 1.0
+ * @since 2026-10-17
+ *
+ * Implementation of the fixed-size thread pool.
+ */
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace algo;
+
+using namespace std;
+
+algo::ThreadPool::ThreadPool(int numThreads)
+{
+	if (numThreads <= 0) {
+		numThreads = max(1u, thread::hardware_concurrency());
+	}
+	workers_.reserve(numThreads - 1);
+	for (int tid = 1; tid < numThreads; ++tid) {
+		workers_.emplace_back(&ThreadPool::workerLoop, this, tid);
+	}
+}
+
+algo::ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stop_ = true;
+	}
+	start_.notify_all();
+	for (auto& t : workers_) {
+		t.join();
+	}
+}
+
+void algo::ThreadPool::run(const function<void(int)>& fn)
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		job_ = &fn;
+		pending_ = static_cast<int>(workers_.size());
+		error_ = nullptr;
+		++generation_;
+	}
+	start_.notify_all();
+
+	// The caller is thread 0.
+	exception_ptr error;
+	try {
+		fn(0);
+	} catch (...) {
+		error = current_exception();
+	}
+
+	unique_lock<mutex> lock(mutex_);
+	done_.wait(lock, [this] { return pending_ == 0; });
+	job_ = nullptr;
+	if (!error) {
+		error = error_;
+	}
+	lock.unlock();
+	if (error) {
+		rethrow_exception(error);
+	}
+}
+
+void algo::ThreadPool::parallelFor(size_t first, size_t last, size_t grain,
+	const function<void(int, size_t, size_t)>& fn)
+{
+	if (first >= last) {
+		return;
+	}
+	grain = max<size_t>(grain, 1);
+	atomic<size_t> next(first);
+	run([&](int tid) {
+		for (;;) {
+			size_t begin = next.fetch_add(grain, memory_order_relaxed);
+			if (begin >= last) {
+				break;
+			}
+			fn(tid, begin, min(begin + grain, last));
+		}
+	});
+}
+
+void algo::ThreadPool::workerLoop(int tid)
+{
+	uint64_t seen = 0;
+	for (;;) {
+		const function<void(int)>* job;
+		{
+			unique_lock<mutex> lock(mutex_);
+			start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+			if (stop_) {
+				return;
+			}
+			seen = generation_;
+			job = job_;
+		}
+
+		exception_ptr error;
+		try {
+			(*job)(tid);
+		} catch (...) {
+			error = current_exception();
+		}
+
+		lock_guard<mutex> lock(mutex_);
+		if (error && !error_) {
+			error_ = error;
+		}
+		if (--pending_ == 0) {
+			done_.notify_one();
+		}
+	}
+}
+
+// EOF